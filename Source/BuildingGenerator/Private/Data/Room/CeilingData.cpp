@@ -2,3 +2,35 @@
 
 
 #include "Data/Room/CeilingData.h"
+
+#include "Generators/Rooms/Kernel/RoomGenerationKernel.h"
+#include "Misc/ScopeLock.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
+
+TSharedRef<const FKernelTilePool, ESPMode::ThreadSafe> UCeilingData::GetCompiledCeilingTilePool() const
+{
+	FScopeLock Lock(&CompiledPoolLock);
+	if (!CompiledCeilingTilePool.IsValid())
+	{
+		TSharedRef<FKernelTilePool, ESPMode::ThreadSafe> NewPool = MakeShared<FKernelTilePool, ESPMode::ThreadSafe>();
+		URoomGenerationHelpers::CompileTilePool(CeilingTilePool, *NewPool);
+		CompiledCeilingTilePool = NewPool;
+	}
+	return CompiledCeilingTilePool.ToSharedRef();
+}
+
+void UCeilingData::InvalidateCompiledPools()
+{
+	FScopeLock Lock(&CompiledPoolLock);
+	CompiledCeilingTilePool.Reset();
+}
+
+#if WITH_EDITOR
+void UCeilingData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Footprints, weights or rotations may have changed, rooms already holding the old pool keep their copy
+	InvalidateCompiledPools();
+}
+#endif
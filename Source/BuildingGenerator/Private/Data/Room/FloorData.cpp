@@ -2,3 +2,35 @@
 
 
 #include "Data/Room/FloorData.h"
+
+#include "Generators/Rooms/Kernel/RoomGenerationKernel.h"
+#include "Misc/ScopeLock.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
+
+TSharedRef<const FKernelTilePool, ESPMode::ThreadSafe> UFloorData::GetCompiledFloorTilePool() const
+{
+	FScopeLock Lock(&CompiledPoolLock);
+	if (!CompiledFloorTilePool.IsValid())
+	{
+		TSharedRef<FKernelTilePool, ESPMode::ThreadSafe> NewPool = MakeShared<FKernelTilePool, ESPMode::ThreadSafe>();
+		URoomGenerationHelpers::CompileTilePool(FloorTilePool, *NewPool);
+		CompiledFloorTilePool = NewPool;
+	}
+	return CompiledFloorTilePool.ToSharedRef();
+}
+
+void UFloorData::InvalidateCompiledPools()
+{
+	FScopeLock Lock(&CompiledPoolLock);
+	CompiledFloorTilePool.Reset();
+}
+
+#if WITH_EDITOR
+void UFloorData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Footprints, weights or rotations may have changed, rooms already holding the old pool keep their copy
+	InvalidateCompiledPools();
+}
+#endif
@@ -2,3 +2,54 @@
 
 
 #include "Data/Room/WallData.h"
+
+#include "Engine/StaticMesh.h"
+#include "Generators/Rooms/Kernel/RoomGenerationKernel.h"
+#include "Misc/ScopeLock.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
+
+TSharedRef<const FKernelWallModuleTable, ESPMode::ThreadSafe> UWallData::GetCompiledWallModuleTable() const
+{
+	FScopeLock Lock(&CompiledPoolLock);
+	if (!CompiledWallModuleTable.IsValid())
+	{
+		TSharedRef<FKernelWallModuleTable, ESPMode::ThreadSafe> NewTable = MakeShared<FKernelWallModuleTable, ESPMode::ThreadSafe>();
+		URoomGenerationHelpers::CompileWallModuleTable(AvailableWallModules, *NewTable);
+		CompiledWallModuleTable = NewTable;
+	}
+	return CompiledWallModuleTable.ToSharedRef();
+}
+
+FTransform UWallData::GetStackSocketTransform(UStaticMesh* Mesh) const
+{
+	FScopeLock Lock(&CompiledPoolLock);
+	if (const FTransform* Cached = StackSocketTransforms.Find(Mesh)) return *Cached;
+
+	FVector SocketLocation;
+	FRotator SocketRotation;
+	if (!URoomGenerationHelpers::GetMeshSocketTransformWithFallback(Mesh, FName("TopBackCenter"), SocketLocation, SocketRotation,
+		FVector(0, 0, WallHeight)))
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("UWallData::GetStackSocketTransform - %s has no TopBackCenter socket, using WallHeight"),
+			*GetNameSafe(Mesh));
+	}
+
+	return StackSocketTransforms.Add(Mesh, FTransform(SocketRotation, SocketLocation));
+}
+
+void UWallData::InvalidateCompiledPools()
+{
+	FScopeLock Lock(&CompiledPoolLock);
+	CompiledWallModuleTable.Reset();
+	StackSocketTransforms.Empty();
+}
+
+#if WITH_EDITOR
+void UWallData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Module footprints, weights or WallHeight may have changed
+	InvalidateCompiledPools();
+}
+#endif
@@ -2,3 +2,155 @@
 
 
 #include "Generators/Building/BuildingGen.h"
+#include "Async/ParallelFor.h"
+#include "Data/Room/CeilingData.h"
+#include "Data/Room/RoomData.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Generators/Rooms/RoomGenerator.h"
+#include "Generators/Rooms/UniformRoomGenerator.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
+
+#pragma region Batch Generation
+bool UBuildingGen::GenerateRoomBatch(const TArray<FRoomBatchJob>& Jobs)
+{
+	check(IsInGameThread());
+
+	if (bBatchRunning)
+	{ UE_LOG(LogTemp, Warning, TEXT("UBuildingGen::GenerateRoomBatch - A batch is already running")); return false; }
+
+	if (Jobs.Num() == 0)
+	{ UE_LOG(LogTemp, Warning, TEXT("UBuildingGen::GenerateRoomBatch - No jobs")); return false; }
+
+	bBatchRunning = true;
+	PendingJobs = Jobs;
+	AssetHandles.Reset();
+
+	// PHASE 1: Asset streaming, style assets first (the mesh references live inside them)
+	TArray<FSoftObjectPath> Paths;
+	for (const FRoomBatchJob& Job : PendingJobs) URoomGenerationHelpers::GatherRoomStyleAssets(Job.RoomData, Paths);
+	RequestBatchAssets(MoveTemp(Paths), &UBuildingGen::OnBatchStylesLoaded);
+	return true;
+}
+#pragma endregion
+
+#pragma region Batch Helpers
+void UBuildingGen::OnBatchStylesLoaded()
+{
+	TArray<FSoftObjectPath> Paths;
+	for (const FRoomBatchJob& Job : PendingJobs) URoomGenerationHelpers::GatherRoomMeshAssets(Job.RoomData, Paths);
+
+	UE_LOG(LogTemp, Log, TEXT("UBuildingGen::OnBatchStylesLoaded - Streaming %d meshes"), Paths.Num());
+	RequestBatchAssets(MoveTemp(Paths), &UBuildingGen::OnBatchMeshesLoaded);
+}
+
+void UBuildingGen::OnBatchMeshesLoaded()
+{
+	// Compiled pools are shared between rooms, build each one once here rather than racing on the workers
+	for (const FRoomBatchJob& Job : PendingJobs)
+	{
+		if (!Job.RoomData) continue;
+		if (UFloorData* FloorStyleData = Job.RoomData->FloorStyleData.Get()) FloorStyleData->GetCompiledFloorTilePool();
+		if (UWallData* WallStyleData = Job.RoomData->WallStyleData.Get()) WallStyleData->GetCompiledWallModuleTable();
+		if (UCeilingData* CeilingStyleData = Job.RoomData->CeilingStyleData.Get()) CeilingStyleData->GetCompiledCeilingTilePool();
+	}
+
+	RunBatch();
+}
+
+void UBuildingGen::RunBatch()
+{
+	TArray<FRoomBatchResult> Results;
+	Results.SetNum(PendingJobs.Num());
+
+	// PHASE 2: Game thread setup (UObject creation)
+	TArray<URoomGenerator*> Generators;
+	Generators.SetNumZeroed(PendingJobs.Num());
+
+	for (int32 i = 0; i < PendingJobs.Num(); ++i)
+	{
+		const FRoomBatchJob& Job = PendingJobs[i];
+		if (!Job.RoomData)
+		{ UE_LOG(LogTemp, Warning, TEXT("UBuildingGen::RunBatch - Job %d has no RoomData, skipping"), i); continue; }
+
+		if (!Job.RoomData->FloorStyleData.Get() || !Job.RoomData->WallStyleData.Get())
+		{ UE_LOG(LogTemp, Warning, TEXT("UBuildingGen::RunBatch - Job %d is missing style data, skipping"), i); continue; }
+
+		UClass* GeneratorClass = Job.GeneratorClass ? Job.GeneratorClass.Get() : UUniformRoomGenerator::StaticClass();
+		URoomGenerator* Generator = NewObject<URoomGenerator>(this, GeneratorClass);
+		if (!Generator || !Generator->Initialize(Job.RoomData, Job.GridSize, Job.Seed))
+		{ UE_LOG(LogTemp, Warning, TEXT("UBuildingGen::RunBatch - Job %d failed to initialize, skipping"), i); continue; }
+
+		FRoomBatchResult& Result = Results[i];
+		Result.Seed = Generator->GetRoomSeed();
+		Result.CellSize = Generator->GetCellSize();
+
+		const UCeilingData* CeilingStyle = Job.RoomData->CeilingStyleData.Get();
+		if (!CeilingStyle) CeilingStyle = GetDefault<UCeilingData>();
+		Result.CeilingHeight = CeilingStyle->CeilingHeight;
+		Result.CeilingRotation = CeilingStyle->CeilingRotation;
+
+		Generators[i] = Generator;
+	}
+
+	// PHASE 3: Generation stages on the task graph (the game thread waits here, so nothing above can be collected)
+	ParallelFor(PendingJobs.Num(), [&Generators, &Results](int32 Index)
+	{
+		URoomGenerator* Generator = Generators[Index];
+		if (!Generator || !RunRoomStages(Generator)) return;
+
+		FRoomBatchResult& Result = Results[Index];
+		Result.FloorMeshes = Generator->GetPlacedFloorMeshes();
+		Result.Walls = Generator->GetPlacedWalls();
+		Result.Corners = Generator->GetPlacedCorners();
+		Result.Doorways = Generator->GetPlacedDoorways();
+		Result.CeilingTiles = Generator->GetPlacedCeilingTiles();
+		Result.MeshPalette = Generator->GetPlacedMeshPalette();
+		Result.WallModulePalette = Generator->GetPlacedWallModulePalette();
+		Result.bSuccess = true;
+	});
+
+	// PHASE 4: Release the generators and assets, hand the results out
+	int32 SuccessCount = 0;
+	for (int32 i = 0; i < PendingJobs.Num(); ++i)
+	{
+		if (Generators[i]) Generators[i]->MarkAsGarbage();
+		if (Results[i].bSuccess) SuccessCount++;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UBuildingGen::RunBatch - Generated %d/%d rooms"), SuccessCount, PendingJobs.Num());
+
+	PendingJobs.Reset();
+	AssetHandles.Reset();
+	bBatchRunning = false;
+	OnBatchFinished.Broadcast(this, Results);
+}
+
+void UBuildingGen::RequestBatchAssets(TArray<FSoftObjectPath>&& Paths, void (UBuildingGen::*OnLoaded)())
+{
+	if (Paths.Num() == 0) { (this->*OnLoaded)(); return; }
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths),
+		FStreamableDelegate::CreateUObject(this, OnLoaded));
+
+	// Failed requests never call back, carry on with whatever is resident (missing assets fail their stage)
+	if (!Handle.IsValid()) { (this->*OnLoaded)(); return; }
+
+	// Resident assets may complete the request (and the whole batch) before it returns
+	if (bBatchRunning) AssetHandles.Add(Handle);
+}
+
+bool UBuildingGen::RunRoomStages(URoomGenerator* Generator)
+{
+	Generator->CreateGrid();
+
+	// Stages without conflicting state (e.g. ceiling and walls) of this room run concurrently
+	FRoomStageGraph StageGraph;
+	Generator->BuildStageGraph(StageGraph);
+
+	if (!StageGraph.Execute(*Generator))
+	{ UE_LOG(LogTemp, Warning, TEXT("UBuildingGen::RunRoomStages - A required stage failed")); return false; }
+
+	return true;
+}
+#pragma endregion
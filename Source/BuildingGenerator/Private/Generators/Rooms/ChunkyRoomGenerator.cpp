@@ -4,6 +4,30 @@
 
 #include "Utilities/Generation/RoomGenerationHelpers.h"
 
+namespace
+{
+	// Perimeter mask bits, one per side whose neighbour is void or out of bounds (+X=North, +Y=East)
+	constexpr uint8 NeighbourNorth = 1 << 0;
+	constexpr uint8 NeighbourSouth = 1 << 1;
+	constexpr uint8 NeighbourEast  = 1 << 2;
+	constexpr uint8 NeighbourWest  = 1 << 3;
+
+	// Corner lookup by perimeter mask (-1 = not a corner: fewer/more than two open sides, or two opposite sides)
+	constexpr int8 CornerNone = -1;
+	constexpr int8 CornerNE = static_cast<int8>(ECornerPosition::NorthEast);
+	constexpr int8 CornerNW = static_cast<int8>(ECornerPosition::NorthWest);
+	constexpr int8 CornerSE = static_cast<int8>(ECornerPosition::SouthEast);
+	constexpr int8 CornerSW = static_cast<int8>(ECornerPosition::SouthWest);
+
+	constexpr int8 CornerLookup[16] =
+	{
+		CornerNone, CornerNone, CornerNone, CornerNone,		// -, N, S, NS
+		CornerNone, CornerNE,   CornerSE,   CornerNone,		// E, NE, SE, NSE
+		CornerNone, CornerNW,   CornerSW,   CornerNone,		// W, NW, SW, NSW
+		CornerNone, CornerNone, CornerNone, CornerNone		// EW, NEW, SEW, NSEW
+	};
+}
+
 void UChunkyRoomGenerator::CreateGrid()
 {
 	   if (!bIsInitialized)
@@ -12,19 +36,15 @@ void UChunkyRoomGenerator::CreateGrid()
     // SET TARGET CELL TYPE FOR FLOOR GENERATION
     FloorTargetCellType = EGridCellType::ECT_Custom;
 
-    // Initialize random stream
-    if (RandomSeed == -1) { RandomStream.Initialize(FMath::Rand()); }
-    else{ RandomStream.Initialize(RandomSeed); }
+    // Initialize random stream (RandomSeed overrides the room seed, -1 keeps the seed passed to Initialize)
+    if (RandomSeed != -1) { SetRoomSeed(RandomSeed); }
+    FRandomStream& Stream = BeginRandomStage(ERoomRandomStage::Layout);
 
     UE_LOG(LogTemp, Log, TEXT("UChunkyRoomGenerator::CreateGrid - Creating chunky room..."));
 
     // Step 1: Initialize grid (all cells VOID - outside room)
     int32 TotalCells = GridSize.X * GridSize.Y;
-    GridState.SetNum(TotalCells);
-    for (EGridCellType& Cell : GridState)
-    {
-        Cell = EGridCellType::ECT_Void;  // CHANGED: Outside room
-    }
+    GridKernel.Reset(GridSize, EKernelCellType::ECT_Void, ToKernelCell(FloorTargetCellType));  // CHANGED: Outside room
 
     // Step 2: Calculate base room bounds (starting at 0,0)
     BaseRoomSize.X = FMath::Max(4, (int32)(GridSize.X * BaseRoomPercentage));
@@ -39,12 +59,12 @@ void UChunkyRoomGenerator::CreateGrid()
     MarkRectangle(BaseRoomStart.X, BaseRoomStart.Y, BaseRoomSize.X, BaseRoomSize.Y);
 
     // Step 4: Add random protrusions
-    int32 NumProtrusions = RandomStream.RandRange(MinProtrusions, MaxProtrusions);
+    int32 NumProtrusions = Stream.RandRange(MinProtrusions, MaxProtrusions);
     UE_LOG(LogTemp, Verbose, TEXT("  Adding %d protrusions..."), NumProtrusions);
 
     for (int32 i = 0; i < NumProtrusions; ++i)
     {
-        AddRandomProtrusion();
+        AddRandomProtrusion(Stream);
     }
 
     // Step 5: Log statistics
@@ -60,16 +80,18 @@ void UChunkyRoomGenerator::CreateGrid()
 
 bool UChunkyRoomGenerator::GenerateFloor()
 {
+	FMemMark ScratchMark(FMemStack::Get());
+
 if (!bIsInitialized)
 	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateFloor - Generator not initialized!")); return false; }
 
 	if (! RoomData || !RoomData->FloorStyleData)
 	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator:: GenerateFloor - FloorData not assigned!")); return false; }
 
-	// Load FloorData and keep strong reference throughout function
-	UFloorData* FloorStyleData = RoomData->FloorStyleData.LoadSynchronous();
+	// Style assets are streamed before generation, stages never load
+	UFloorData* FloorStyleData = RoomData->FloorStyleData.Get();
 	if (!FloorStyleData)
-	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateFloor - Failed to load FloorStyleData!")); return false; }
+	{ UE_LOG(LogTemp, Error, TEXT("UChunkyRoomGenerator::GenerateFloor - FloorStyleData is not loaded!")); return false; }
 
 	// Validate FloorTilePool exists
 	if (FloorStyleData->FloorTilePool. Num() == 0)
@@ -78,6 +100,7 @@ if (!bIsInitialized)
 	// Clear previous placement data
 	//ClearPlacedFloorMeshes();
 	//ClearPlacedFloorMeshes();
+	FRandomStream& Stream = BeginRandomStage(ERoomRandomStage::Floor);
 	
 	int32 FloorLargeTilesPlaced = 0;
 	int32 FloorMediumTilesPlaced = 0;
@@ -88,12 +111,8 @@ if (!bIsInitialized)
 
  
 	// PHASE 0:  FORCED EMPTY REGIONS (Mark cells as reserved)
- 	TArray<FIntPoint> ForcedEmptyCells = ExpandForcedEmptyRegions();
-	if (ForcedEmptyCells.Num() > 0)
-	{
-		MarkForcedEmptyCells(ForcedEmptyCells);
-		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCells. Num());
-	}
+ 	const int32 ForcedEmptyCount = MarkForcedEmptyRegions();
+	if (ForcedEmptyCount > 0) { UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCount); }
 	
 	// PHASE 1: FORCED PLACEMENTS (Designer overrides - highest priority)
  	int32 ForcedCount = ExecuteForcedPlacements();
@@ -102,23 +121,24 @@ if (!bIsInitialized)
 	// PHASE 2: GREEDY FILL (Large → Medium → Small)
  	// Use the FloorData pointer we loaded at the top (safer than re-accessing)
 	const TArray<FMeshPlacementInfo>& FloorMeshes = FloorStyleData->FloorTilePool;
+	const TSharedRef<const FKernelTilePool, ESPMode::ThreadSafe> FloorPool = FloorStyleData->GetCompiledFloorTilePool();
 	UE_LOG(LogTemp, Log, TEXT("  Phase 2: Greedy fill with %d tile options"), FloorMeshes.Num());
 
 	// Large tiles (400x400, 200x400, 400x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(4, 4), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(2, 4), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(4, 2), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 
 	// Medium tiles (200x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(2, 2), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 
 	// Small tiles (100x200, 200x100, 100x100)
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(1, 2), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(2, 1), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(1, 1), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 	
 	// PHASE 3: GAP FILL (Fill remaining empty cells with any available mesh)
-	int32 GapFillCount = FillRemainingGaps(FloorMeshes, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	int32 GapFillCount = FillRemainingGaps(FloorMeshes, *FloorPool, Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 	UE_LOG(LogTemp, Log, TEXT("  Phase 3:  Filled %d remaining gaps"), GapFillCount);
  
 	// FINAL STATISTICS
@@ -132,8 +152,18 @@ if (!bIsInitialized)
 	return true;
 }
 
+void UChunkyRoomGenerator::ClearGrid()
+{
+	Super::ClearGrid();
+
+	CornerCellBits.Empty();
+	PerimeterMasks.Empty();
+}
+
 bool UChunkyRoomGenerator::GenerateWalls()
 {
+	FMemMark ScratchMark(FMemStack::Get());
+
 	if (!bIsInitialized)
 	{
 		UE_LOG(LogTemp, Error, TEXT("UChunkyRoomGenerator:: GenerateWalls - Not initialized! "));
@@ -146,23 +176,37 @@ bool UChunkyRoomGenerator::GenerateWalls()
 		return false;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("UChunkyRoomGenerator::GenerateWalls - Starting (skipping %d corner cells)"), 
-		CornerCells.Num());
+	// Corner cells belong to the corner pieces whenever a corner mesh is configured (set, loaded or not, same test as
+	// GenerateCorners). They are classified from the same neighbour masks, so walls don't depend on corners running first
+	WallData = RoomData->WallStyleData.Get();
+	if (!WallData)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UChunkyRoomGenerator::GenerateWalls - WallStyleData is not loaded!"));
+		return false;
+	}
+	const bool bSkipCornerCells = !WallData->DefaultCornerMesh.IsNull();
+
+	UE_LOG(LogTemp, Log, TEXT("UChunkyRoomGenerator::GenerateWalls - Starting (%s corner cells)"), 
+		bSkipCornerCells ? TEXT("skipping") : TEXT("walling"));
 
 	// Clear previous walls
 	ClearPlacedWalls();
+	ResetBaseWallSegments();
+	FRandomStream& Stream = BeginRandomStage(ERoomRandomStage::Walls);
 
-	// Fill each edge using dual detection (void + boundaries), skipping corners
-	FillChunkyWallEdge(EWallEdge::North);
-	FillChunkyWallEdge(EWallEdge::South);
-	FillChunkyWallEdge(EWallEdge::East);
-	FillChunkyWallEdge(EWallEdge::West);
+	// One pass collects the straight runs of every edge (void + boundaries), skipping corners
+	TKernelScratchArray<FChunkyWallRun> EdgeRuns[4];
+	TracePerimeter(EdgeRuns, bSkipCornerCells);
+
+	FillChunkyWallEdge(EWallEdge::North, EdgeRuns[0], Stream);
+	FillChunkyWallEdge(EWallEdge::South, EdgeRuns[1], Stream);
+	FillChunkyWallEdge(EWallEdge::East, EdgeRuns[2], Stream);
+	FillChunkyWallEdge(EWallEdge::West, EdgeRuns[3], Stream);
 
 	UE_LOG(LogTemp, Log, TEXT("  Placed %d base wall segments"), PlacedBaseWallSegments.Num());
 
 	// Spawn middle and top layers
-	SpawnMiddleWallLayers();
-	SpawnTopWallLayer();
+	StackWallLayers();
 
 	UE_LOG(LogTemp, Log, TEXT("UChunkyRoomGenerator::GenerateWalls - Complete!  %d walls placed"), 
 		PlacedWallMeshes.Num());
@@ -184,87 +228,79 @@ bool UChunkyRoomGenerator::GenerateCorners()
         return false;
     }
 
-    // Load WallData
-    WallData = RoomData->WallStyleData. LoadSynchronous();
-    if (!WallData || ! WallData->DefaultCornerMesh.IsValid())
+    WallData = RoomData->WallStyleData.Get();
+    if (!WallData)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UChunkyRoomGenerator::GenerateCorners - WallStyleData is not loaded!"));
+        return false;
+    }
+
+    if (WallData->DefaultCornerMesh.IsNull())
     {
         UE_LOG(LogTemp, Warning, TEXT("UChunkyRoomGenerator::GenerateCorners - No corner mesh defined in WallData"));
         return false;
     }
 
-    // Load corner mesh
+    // Corner mesh must be resident (streamed with the room)
     TSoftObjectPtr<UStaticMesh> CornerMeshPtr = WallData->DefaultCornerMesh;
     if (!CornerMeshPtr.IsValid())
     {
-        UE_LOG(LogTemp, Error, TEXT("UChunkyRoomGenerator::GenerateCorners - Failed to load corner mesh"));
+        UE_LOG(LogTemp, Error, TEXT("UChunkyRoomGenerator::GenerateCorners - Corner mesh is not loaded"));
         return false;
     }
 
     UE_LOG(LogTemp, Log, TEXT("UChunkyRoomGenerator::GenerateCorners - Starting corner detection"));
 
     // Clear previous corner data
-    CornerCells. Empty();
+    CornerCellBits.Init(false, GridSize.X * GridSize.Y);
     ClearPlacedCorners();
 
+    // Neighbour masks for every floor cell in one pass
+    TracePerimeter(nullptr, false);
+
     int32 CornersPlaced = 0;
 
-    // Scan all floor cells for corners
-    for (int32 Y = 0; Y < GridSize. Y; ++Y)
+    for (int32 Index = 0; Index < PerimeterMasks.Num(); ++Index)
     {
-        for (int32 X = 0; X < GridSize.X; ++X)
-        {
-            FIntPoint Cell(X, Y);
-
-            // Must be a floor cell
-            if (GetCellState(Cell) != EGridCellType::ECT_FloorMesh)
-                continue;
+        // Interior and non-floor cells have an empty mask
+        ECornerPosition CornerPos;
+        if (!GetCornerFromMask(PerimeterMasks[Index], CornerPos))
+            continue;
 
-            // Check if this is a corner cell
-            TArray<EWallEdge> AdjacentVoidEdges;
-            if (! IsCornerCell(Cell, AdjacentVoidEdges))
-                continue;
+        const FIntPoint Cell(Index % GridSize.X, Index / GridSize.X);
 
-            // Determine corner position from edges
-            ECornerPosition CornerPos = GetCornerPositionFromEdges(AdjacentVoidEdges);
-            
-            if (CornerPos == ECornerPosition::None)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("  Invalid corner position at (%d,%d)"), Cell.X, Cell.Y);
-                continue;
-            }
-
-            UE_LOG(LogTemp, Verbose, TEXT("  Found corner at (%d,%d) - Type: %s"),
-                Cell.X, Cell.Y, *UEnum::GetValueAsString(CornerPos));
+        UE_LOG(LogTemp, Verbose, TEXT("  Found corner at (%d,%d) - Type: %s"),
+            Cell.X, Cell.Y, *UEnum::GetValueAsString(CornerPos));
 
-            // Calculate corner position (center of cell)
-            FVector CornerPosition;
-            CornerPosition.X = Cell.X * CellSize + (CellSize * 0.5f);
-            CornerPosition.Y = Cell.Y * CellSize + (CellSize * 0.5f);
-            CornerPosition.Z = 0.0f;  // Floor level
+        // Calculate corner position (center of cell)
+        FVector CornerPosition;
+        CornerPosition.X = Cell.X * CellSize + (CellSize * 0.5f);
+        CornerPosition.Y = Cell.Y * CellSize + (CellSize * 0.5f);
+        CornerPosition.Z = 0.0f;  // Floor level
 
-            // Apply corner-specific position offsets from WallData (if configured)
-            FVector PositionOffset = GetCornerPositionOffset(CornerPos);
-            CornerPosition += PositionOffset;
+        // Apply corner-specific position offsets from WallData (if configured)
+        FVector PositionOffset = GetCornerPositionOffset(CornerPos);
+        CornerPosition += PositionOffset;
 
-            // Create transform (no rotation needed for square mesh)
-            FTransform CornerTransform(FRotator::ZeroRotator, CornerPosition, FVector::OneVector);
+        // Create transform (no rotation needed for square mesh)
+        FTransform CornerTransform(FRotator::ZeroRotator, CornerPosition, FVector::OneVector);
 
-            // Create FPlacedCornerInfo
-            FPlacedCornerInfo CornerInfo;
-            CornerInfo.Corner = CornerPos;
-            CornerInfo.Transform = CornerTransform;
-            CornerInfo. CornerMesh = CornerMeshPtr;
+        // Create FPlacedCornerInfo
+        FPlacedCornerInfo CornerInfo;
+        CornerInfo.Corner = CornerPos;
+        CornerInfo.Transform = CornerTransform;
+        CornerInfo. CornerMesh = CornerMeshPtr;
 
-            PlacedCornerMeshes.Add(CornerInfo);
+        PlacedCornerMeshes.Add(CornerInfo);
+        PublishPlacement(ERoomMeshCategory::Corner, CornerInfo.CornerMesh, CornerInfo.Transform);
 
-            // Mark cell as corner (so walls will skip it)
-            CornerCells.Add(Cell);
+        // Mark cell as corner (so walls will skip it)
+        CornerCellBits[Index] = true;
 
-            CornersPlaced++;
+        CornersPlaced++;
 
-            UE_LOG(LogTemp, VeryVerbose, TEXT("    Placed %s corner at (%d,%d)"),
-                *UEnum::GetValueAsString(CornerPos), Cell.X, Cell.Y);
-        }
+        UE_LOG(LogTemp, VeryVerbose, TEXT("    Placed %s corner at (%d,%d)"),
+            *UEnum::GetValueAsString(CornerPos), Cell.X, Cell.Y);
     }
 
     UE_LOG(LogTemp, Log, TEXT("UChunkyRoomGenerator::GenerateCorners - Complete! %d corners placed"), CornersPlaced);
@@ -285,31 +321,19 @@ bool UChunkyRoomGenerator::GenerateCeiling()
 #pragma region Internal Helpers
 void UChunkyRoomGenerator::MarkRectangle(int32 StartX, int32 StartY, int32 Width, int32 Height)
 {
-	// Mark all cells in rectangle as floor
-	for (int32 Y = 0; Y < Height; ++Y)
-	{
-		for (int32 X = 0; X < Width; ++X)
-		{
-			FIntPoint Cell(StartX + X, StartY + Y);
-			
-			// Bounds check
-			if (IsValidGridCoordinate(Cell))
-			{
-				SetCellState(Cell, EGridCellType::ECT_Custom);
-			}
-		}
-	}
+	// Mark all cells in rectangle as floor (kernel clips to grid bounds)
+	GridKernel.MarkArea(FIntPoint(StartX, StartY), FIntPoint(Width, Height), EKernelCellType::ECT_Custom);
 }
 
-void UChunkyRoomGenerator::AddRandomProtrusion()
+void UChunkyRoomGenerator::AddRandomProtrusion(FRandomStream& Stream)
 {
 	// Pick random edge (0=North, 1=South, 2=East, 3=West)
-	int32 EdgeIndex = RandomStream.RandRange(0, 3);
+	int32 EdgeIndex = Stream.RandRange(0, 3);
 	EWallEdge Edge = (EWallEdge)EdgeIndex;
 
 	// Pick random protrusion dimensions
-	int32 ProtrusionWidth = RandomStream.RandRange(MinProtrusionSize, MaxProtrusionSize);
-	int32 ProtrusionDepth = RandomStream.RandRange(MinProtrusionSize, MaxProtrusionSize);
+	int32 ProtrusionWidth = Stream.RandRange(MinProtrusionSize, MaxProtrusionSize);
+	int32 ProtrusionDepth = Stream.RandRange(MinProtrusionSize, MaxProtrusionSize);
 
 	// Calculate protrusion rectangle based on edge
 	FIntPoint Start;
@@ -321,7 +345,7 @@ void UChunkyRoomGenerator::AddRandomProtrusion()
 		{
 			// Pick random position along top edge
 			int32 EdgeLength = BaseRoomSize.X;
-			int32 Position = RandomStream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
+			int32 Position = Stream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
 			
 			Start = FIntPoint(BaseRoomStart.X + Position, BaseRoomStart.Y + BaseRoomSize.Y);
 			Size = FIntPoint(ProtrusionWidth, ProtrusionDepth);
@@ -332,7 +356,7 @@ void UChunkyRoomGenerator::AddRandomProtrusion()
 		{
 			// Pick random position along bottom edge
 			int32 EdgeLength = BaseRoomSize.X;
-			int32 Position = RandomStream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
+			int32 Position = Stream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
 			
 			Start = FIntPoint(BaseRoomStart.X + Position, BaseRoomStart.Y - ProtrusionDepth);
 			Size = FIntPoint(ProtrusionWidth, ProtrusionDepth);
@@ -343,7 +367,7 @@ void UChunkyRoomGenerator::AddRandomProtrusion()
 		{
 			// Pick random position along right edge
 			int32 EdgeLength = BaseRoomSize.Y;
-			int32 Position = RandomStream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
+			int32 Position = Stream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
 			
 			Start = FIntPoint(BaseRoomStart.X + BaseRoomSize.X, BaseRoomStart.Y + Position);
 			Size = FIntPoint(ProtrusionDepth, ProtrusionWidth);
@@ -354,7 +378,7 @@ void UChunkyRoomGenerator::AddRandomProtrusion()
 		{
 			// Pick random position along left edge
 			int32 EdgeLength = BaseRoomSize.Y;
-			int32 Position = RandomStream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
+			int32 Position = Stream.RandRange(0, FMath::Max(1, EdgeLength - ProtrusionWidth));
 			
 			Start = FIntPoint(BaseRoomStart.X - ProtrusionDepth, BaseRoomStart.Y + Position);
 			Size = FIntPoint(ProtrusionDepth, ProtrusionWidth);
@@ -447,16 +471,83 @@ TArray<FIntPoint> UChunkyRoomGenerator::GetPerimeterCells() const
 	return PerimeterCells;
 }
 
-void UChunkyRoomGenerator::FillChunkyWallEdge(EWallEdge Edge)
+void UChunkyRoomGenerator::TracePerimeter(TKernelScratchArray<FChunkyWallRun>* OutRuns, bool bSkipCornerCells)
+{
+	const TArray<EKernelCellType>& Cells = GridKernel.GetCells();
+	const int32 Width = GridSize.X;
+	const int32 Height = GridSize.Y;
+
+	PerimeterMasks.Reset();
+	PerimeterMasks.SetNumZeroed(Width * Height);
+
+	auto IsOpen = [&Cells, Width, Height](int32 X, int32 Y)
+	{ return X < 0 || X >= Width || Y < 0 || Y >= Height || Cells[Y * Width + X] == EKernelCellType::ECT_Void; };
+
+	// Extend the open run of one edge or close it, Fixed = coordinate shared by the run, Along = moving coordinate
+	auto StepRun = [OutRuns](int32& OpenStart, bool bWallCell, int32 Along, int32 EdgeIndex, int32 Fixed)
+	{
+		if (bWallCell) { if (OpenStart == INDEX_NONE) OpenStart = Along; return; }
+		if (OpenStart == INDEX_NONE) return;
+
+		if (OutRuns)
+		{
+			FChunkyWallRun& Run = OutRuns[EdgeIndex].AddDefaulted_GetRef();
+			Run.StartCell = EdgeIndex < 2 ? FIntPoint(Fixed, OpenStart) : FIntPoint(OpenStart, Fixed);
+			Run.Length = Along - OpenStart;
+		}
+		OpenStart = INDEX_NONE;
+	};
+
+	// North/South runs advance along Y (one open run per column), East/West along X (one per row)
+	TArray<int32> OpenNorth, OpenSouth;
+	OpenNorth.Init(INDEX_NONE, Width);
+	OpenSouth.Init(INDEX_NONE, Width);
+	int32 OpenEast = INDEX_NONE;
+	int32 OpenWest = INDEX_NONE;
+
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		for (int32 X = 0; X < Width; ++X)
+		{
+			const int32 Index = Y * Width + X;
+			uint8 Mask = 0;
+			if (Cells[Index] == EKernelCellType::ECT_FloorMesh)
+			{
+				if (IsOpen(X + 1, Y)) Mask |= NeighbourNorth;
+				if (IsOpen(X - 1, Y)) Mask |= NeighbourSouth;
+				if (IsOpen(X, Y + 1)) Mask |= NeighbourEast;
+				if (IsOpen(X, Y - 1)) Mask |= NeighbourWest;
+				PerimeterMasks[Index] = Mask;
+			}
+
+			// Corner cells are covered by the corner piece and break every run
+			ECornerPosition CornerPos;
+			const uint8 WallMask = bSkipCornerCells && GetCornerFromMask(Mask, CornerPos) ? 0 : Mask;
+			StepRun(OpenNorth[X], (WallMask & NeighbourNorth) != 0, Y, 0, X);
+			StepRun(OpenSouth[X], (WallMask & NeighbourSouth) != 0, Y, 1, X);
+			StepRun(OpenEast, (WallMask & NeighbourEast) != 0, X, 2, Y);
+			StepRun(OpenWest, (WallMask & NeighbourWest) != 0, X, 3, Y);
+		}
+
+		StepRun(OpenEast, false, Width, 2, Y);
+		StepRun(OpenWest, false, Width, 3, Y);
+	}
+
+	for (int32 X = 0; X < Width; ++X)
+	{
+		StepRun(OpenNorth[X], false, Height, 0, X);
+		StepRun(OpenSouth[X], false, Height, 1, X);
+	}
+}
+
+void UChunkyRoomGenerator::FillChunkyWallEdge(EWallEdge Edge, const TKernelScratchArray<FChunkyWallRun>& Runs, FRandomStream& Stream)
 {
     if (! RoomData || RoomData->WallStyleData.IsNull()) return;
 
-    WallData = RoomData->WallStyleData.LoadSynchronous();
+    WallData = RoomData->WallStyleData.Get();
     if (!WallData || WallData->AvailableWallModules. Num() == 0) return;
 
-    // Get perimeter cells for this edge (replaces GetEdgeCellIndices)
-    TArray<FIntPoint> EdgeCells = GetPerimeterCellsForEdge(Edge);
-    if (EdgeCells.Num() == 0) return;
+    if (Runs.Num() == 0) return;
 	
     FRotator WallRotation = URoomGenerationHelpers::GetWallRotationForEdge(Edge);
     
@@ -466,117 +557,63 @@ void UChunkyRoomGenerator::FillChunkyWallEdge(EWallEdge Edge)
     float EastOffset = WallData->EastWallOffsetY;
     float WestOffset = WallData->WestWallOffsetY;
 
-    UE_LOG(LogTemp, Verbose, TEXT("  Filling %s edge with %d cells"),
-        *UEnum::GetValueAsString(Edge), EdgeCells.Num());
+    UE_LOG(LogTemp, Verbose, TEXT("  Filling %s edge with %d runs"), *UEnum::GetValueAsString(Edge), Runs.Num());
 
-    // GREEDY BIN PACKING:  Fill with largest modules first
-    int32 CurrentCell = 0;
+    // Fewest-module packing, modules may not bridge gaps so each straight run is packed separately
+    const TSharedRef<const FKernelWallModuleTable, ESPMode::ThreadSafe> ModuleTable = WallData->GetCompiledWallModuleTable();
 
-    while (CurrentCell < EdgeCells. Num())
-    {
-        int32 SpaceLeft = EdgeCells.Num() - CurrentCell;
+    // Coordinate system: +X=North, +Y=East
+    // North/South walls extend along Y-axis, East/West walls along X-axis
+    const FIntPoint RunStep = (Edge == EWallEdge::North || Edge == EWallEdge::South) ? FIntPoint(0, 1) : FIntPoint(1, 0);
 
-        // Find largest module that fits
-        const FWallModule* BestModule = nullptr;
+    TKernelScratchArray<FKernelWallSpan> Spans;
+    for (const FChunkyWallRun& Run : Runs)
+    {
+        Spans.Reset();
+        FRoomGenerationKernel::PackWallRun(Run.Length, *ModuleTable, [](int32) { return false; }, Stream, Spans);
 
-        for (const FWallModule& Module : WallData->AvailableWallModules)
+        for (const FKernelWallSpan& Span : Spans)
         {
-      // Check if module fits remaining space
-            if (Module.Y_AxisFootprint <= SpaceLeft)
+            const FWallModule& Module = WallData->AvailableWallModules[Span.ModuleId];
+
+            UStaticMesh* BaseMesh = Module.BaseMesh.Get();
+            if (!BaseMesh)
             {
-                // Check if VOID cells are consecutive
-                bool bCellsConsecutive = true;
-                
-                for (int32 i = 1; i < Module.Y_AxisFootprint; ++i)
-                {
-                	FIntPoint CurrentCellPos = EdgeCells[CurrentCell + i - 1];
-                	FIntPoint NextCellPos = EdgeCells[CurrentCell + i];
-                    
-                	// Check adjacency based on edge direction
-                	// Coordinate system: +X=North, +Y=East
-                	bool bAdjacent = false;
-                    
-                	if (Edge == EWallEdge::North || Edge == EWallEdge:: South)
-                	{
-                		// North/South walls extend East-West (along Y-axis)
-                		// Y should increment by 1, X should stay same
-                		bAdjacent = (NextCellPos. Y == CurrentCellPos.Y + 1) && (NextCellPos.X == CurrentCellPos.X);
-                	}
-                	else // East or West
-                	{
-                		// East/West walls extend North-South (along X-axis)
-                		// X should increment by 1, Y should stay same
-                		bAdjacent = (NextCellPos.X == CurrentCellPos.X + 1) && (NextCellPos.Y == CurrentCellPos.Y);
-                	}
-                    
-                	if (! bAdjacent)
-                	{
-                		bCellsConsecutive = false;
-                		break;
-                	}
-                }
-                
-                if (bCellsConsecutive)
-                {
-                    // Choose largest consecutive module
-                    if (! BestModule || Module.Y_AxisFootprint > BestModule->Y_AxisFootprint)
-                    {
-                        BestModule = &Module;
-                    }
-                }
+                UE_LOG(LogTemp, Warning, TEXT("    Base mesh is not loaded"));
+                continue;
             }
-        }
 
-        if (! BestModule)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("    No wall module fits at void cell %d (remaining:  %d)"), 
-                CurrentCell, SpaceLeft);
-            CurrentCell++;  // Skip this cell
-            continue;
-        }
-
-        // Load base mesh
-        UStaticMesh* BaseMesh = BestModule->BaseMesh. LoadSynchronous();
-        if (!BaseMesh)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("    Failed to load base mesh"));
-            CurrentCell++;
-            continue;
+            // Get starting floor cell for this module
+            const FIntPoint StartCell = Run.StartCell + RunStep * Span.StartIndex;
+
+            // Calculate wall position along the edge of the start cell
+            FVector WallPosition = CalculateWallPositionForSegment(
+                Edge,
+                StartCell,
+                Span.Length,
+                NorthOffset,
+                SouthOffset,
+                EastOffset,
+                WestOffset
+            );
+
+            // Create transform
+            FTransform BaseTransform(WallRotation, WallPosition, FVector::OneVector);
+
+            // Store segment for middle/top spawning (StartCell = coordinate along the wall)
+            FGeneratorWallSegment Segment;
+            Segment.Edge = Edge;
+            Segment. StartCell = RunStep.X ? StartCell.X : StartCell.Y;
+            Segment. SegmentLength = Span.Length;
+            Segment.BaseTransform = BaseTransform;
+            Segment.BaseMesh = BaseMesh;
+            Segment.WallModule = &Module;
+
+            AddBaseWallSegment(Segment);
+
+            UE_LOG(LogTemp, VeryVerbose, TEXT("    Placed %dY module at cell (%d,%d)"),
+                Span.Length, StartCell.X, StartCell.Y);
         }
-
-        // Get starting VOID cell for this module
-        FIntPoint StartVoidCell = EdgeCells[CurrentCell];
-
-        // Calculate wall position using void-based logic
-        FVector WallPosition = CalculateWallPositionForSegment(
-            Edge,
-            StartVoidCell,  // ← Now passing void cell, not floor cell
-            BestModule->Y_AxisFootprint,
-            NorthOffset,
-            SouthOffset,
-            EastOffset,
-            WestOffset
-        );
-
-        // Create transform
-        FTransform BaseTransform(WallRotation, WallPosition, FVector::OneVector);
-
-        // Store segment for middle/top spawning
-        FGeneratorWallSegment Segment;
-        Segment.Edge = Edge;
-        Segment. StartCell = CurrentCell;
-        Segment. SegmentLength = BestModule->Y_AxisFootprint;
-        Segment.BaseTransform = BaseTransform;
-        Segment.BaseMesh = BaseMesh;
-        Segment.WallModule = BestModule;
-
-        PlacedBaseWallSegments.Add(Segment);
-
-        UE_LOG(LogTemp, VeryVerbose, TEXT("    Placed %dY module at void cell (%d,%d)"),
-            BestModule->Y_AxisFootprint, StartVoidCell.X, StartVoidCell.Y);
-
-        // Advance by module footprint
-        CurrentCell += BestModule->Y_AxisFootprint;
     }
 }
 
@@ -592,65 +629,6 @@ FIntPoint UChunkyRoomGenerator::GetDirectionOffset(EWallEdge Direction) const
 	}
 }
 
-TArray<FIntPoint> UChunkyRoomGenerator::GetPerimeterCellsForEdge(EWallEdge Edge) const
-{
-	TArray<FIntPoint> EdgeCells;
-
-	// Get direction offset for this edge
-	FIntPoint EdgeDirection = GetDirectionOffset(Edge);
-    
-	for (int32 Y = 0; Y < GridSize.Y; ++Y)
-	{
-		for (int32 X = 0; X < GridSize.X; ++X)
-		{
-			FIntPoint FloorCell(X, Y);
-            
-			// Must be a floor cell
-			if (GetCellState(FloorCell) != EGridCellType::ECT_FloorMesh)
-				continue;
-
-			// SKIP if this cell is marked as a corner
-			if (IsCellMarkedAsCorner(FloorCell))
-				continue;
-
-			// Check neighbor in edge direction
-			FIntPoint Neighbor = FloorCell + EdgeDirection;
-            
-			// Edge condition:  Neighbor is OUT OF BOUNDS or VOID
-			bool bIsEdge = false;
-            
-			if (!IsValidGridCoordinate(Neighbor))
-			{
-				bIsEdge = true;  // Grid boundary edge
-			}
-			else if (GetCellState(Neighbor) == EGridCellType::ECT_Void)
-			{
-				bIsEdge = true;  // Void edge
-			}
-            
-			if (bIsEdge)
-			{
-				EdgeCells.Add(FloorCell);
-			}
-		}
-	}
-
-	// Sort cells to create a linear sequence
-	if (Edge == EWallEdge::North || Edge == EWallEdge::South)
-	{
-		EdgeCells.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.Y < B.Y; });
-	}
-	else
-	{
-		EdgeCells. Sort([](const FIntPoint& A, const FIntPoint& B) { return A.X < B.X; });
-	}
-
-	UE_LOG(LogTemp, Verbose, TEXT("  GetPerimeterCellsForEdge(%s): Found %d edge cells (corners excluded)"), 
-		*UEnum::GetValueAsString(Edge), EdgeCells.Num());
-
-	return EdgeCells;
-}
-
 FVector UChunkyRoomGenerator:: CalculateWallPositionForSegment(EWallEdge Direction, FIntPoint StartCell,
     int32 ModuleFootprint, float NorthOffset, float SouthOffset, float EastOffset, float WestOffset) const
 {
@@ -706,80 +684,14 @@ FVector UChunkyRoomGenerator:: CalculateWallPositionForSegment(EWallEdge Directi
 #pragma endregion
 
 #pragma region Corner Generation Helpers
-bool UChunkyRoomGenerator::IsCornerCell(FIntPoint Cell, TArray<EWallEdge>& OutAdjacentVoidEdges) const
+bool UChunkyRoomGenerator::GetCornerFromMask(uint8 NeighbourMask, ECornerPosition& OutCorner)
 {
-    OutAdjacentVoidEdges. Empty();
-    
-    // Check all four cardinal directions for void/boundary
-    TArray<EWallEdge> DirectionsToCheck = {EWallEdge::North, EWallEdge:: South, EWallEdge::East, EWallEdge::West};
-    
-    for (EWallEdge Edge : DirectionsToCheck)
-    {
-        FIntPoint Direction = GetDirectionOffset(Edge);
-        FIntPoint Neighbor = Cell + Direction;
-        
-        // Check if neighbor is out of bounds or void
-        if (! IsValidGridCoordinate(Neighbor) || GetCellState(Neighbor) == EGridCellType::ECT_Void)
-        {
-            OutAdjacentVoidEdges.Add(Edge);
-        }
-    }
-    
-    // A corner has void on exactly 2 adjacent sides
-    if (OutAdjacentVoidEdges.Num() != 2)
-        return false;
-    
-    // Check if the two void sides are ADJACENT (not opposite)
-    EWallEdge Edge1 = OutAdjacentVoidEdges[0];
-    EWallEdge Edge2 = OutAdjacentVoidEdges[1];
-    
-    // Opposite pairs (NOT corners):
-    if ((Edge1 == EWallEdge::North && Edge2 == EWallEdge::South) ||
-        (Edge1 == EWallEdge::South && Edge2 == EWallEdge::North) ||
-        (Edge1 == EWallEdge::East && Edge2 == EWallEdge::West) ||
-        (Edge1 == EWallEdge::West && Edge2 == EWallEdge::East))
-    {
-        return false;  // Opposite sides = thin wall, not corner
-    }
-    
-    // Adjacent sides = valid corner
-    return true;
-}
+    const int8 Corner = CornerLookup[NeighbourMask & 0xF];
+    if (Corner < 0) return false;
 
-ECornerPosition UChunkyRoomGenerator::GetCornerPositionFromEdges(const TArray<EWallEdge>& AdjacentEdges) const
-{
-    // Coordinate system: +X=North, +Y=East
-    
-    if (AdjacentEdges.Num() != 2)
-        return ECornerPosition::None;
-    
-    EWallEdge Edge1 = AdjacentEdges[0];
-    EWallEdge Edge2 = AdjacentEdges[1];
-    
-    // Helper lambda to check edge combinations
-    auto ContainsEdges = [&](EWallEdge A, EWallEdge B) -> bool {
-        return (Edge1 == A && Edge2 == B) || (Edge1 == B && Edge2 == A);
-    };
-    
-    // Determine corner position based on which two edges have void
-    if (ContainsEdges(EWallEdge::North, EWallEdge::East))
-    {
-        return ECornerPosition::NorthEast;
-    }
-    else if (ContainsEdges(EWallEdge::North, EWallEdge::West))
-    {
-        return ECornerPosition::NorthWest;
-    }
-    else if (ContainsEdges(EWallEdge::South, EWallEdge::East))
-    {
-        return ECornerPosition:: SouthEast;
-    }
-    else if (ContainsEdges(EWallEdge::South, EWallEdge::West))
-    {
-        return ECornerPosition::SouthWest;
-    }
-    
-    return ECornerPosition:: None;
+    // ECornerPosition::None shares its value with SouthWest, so validity comes from the table, not the enum
+    OutCorner = static_cast<ECornerPosition>(Corner);
+    return true;
 }
 
 FVector UChunkyRoomGenerator::GetCornerPositionOffset(ECornerPosition CornerPos) const
@@ -809,7 +721,9 @@ FVector UChunkyRoomGenerator::GetCornerPositionOffset(ECornerPosition CornerPos)
 
 bool UChunkyRoomGenerator::IsCellMarkedAsCorner(FIntPoint Cell) const
 {
-    return CornerCells.Contains(Cell);
+    if (!IsValidGridCoordinate(Cell)) return false;
+    const int32 Index = Cell.Y * GridSize.X + Cell.X;
+    return CornerCellBits.IsValidIndex(Index) && CornerCellBits[Index];
 }
 
 #pragma endregion
@@ -0,0 +1,673 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generators/Rooms/Kernel/RoomGenerationKernel.h"
+
+namespace
+{
+	/* Gap-fill sizes (largest to smallest) */
+	const FIntPoint GapFillSizes[] = { FIntPoint(1, 4), FIntPoint(4, 1), FIntPoint(1, 2), FIntPoint(2, 1), FIntPoint(1, 1) };
+
+	/* Mask of Count bits starting at Bit (Count in 1..64) */
+	FORCEINLINE uint64 WordRangeMask(int32 Bit, int32 Count)
+	{
+		return (Count >= 64 ? ~0ull : ((1ull << Count) - 1)) << Bit;
+	}
+}
+
+#pragma region Grid
+void FRoomGenerationKernel::Reset(FIntPoint InGridSize, EKernelCellType InitialType, EKernelCellType InFreeType)
+{
+	GridSize = FIntPoint(FMath::Max(0, InGridSize.X), FMath::Max(0, InGridSize.Y));
+	Cells.Init(InitialType, GridSize.X * GridSize.Y);
+
+	WordsPerRow = (GridSize.X + 63) / 64;
+	TypeBits.Init(0, NumCellTypes * GridSize.Y * WordsPerRow);
+	for (int32 Y = 0; Y < GridSize.Y; ++Y) { SetRowBits(GetTypeRow(InitialType, Y), 0, GridSize.X); }
+
+	FreeType = InFreeType;
+	bBlockedSumsDirty = true;
+	bFreeRectsDirty = true;
+}
+
+void FRoomGenerationKernel::Empty()
+{
+	GridSize = FIntPoint::ZeroValue;
+	Cells.Empty();
+	TypeBits.Empty();
+	WordsPerRow = 0;
+	BlockedSums.Empty();
+	bBlockedSumsDirty = true;
+	FreeRects.Empty();
+	bFreeRectsDirty = true;
+}
+
+EKernelCellType FRoomGenerationKernel::GetCell(FIntPoint Coord) const
+{
+	if (!IsValidCoord(Coord)) return EKernelCellType::ECT_Empty;
+	return Cells[CoordToIndex(Coord)];
+}
+
+bool FRoomGenerationKernel::SetCell(FIntPoint Coord, EKernelCellType CellType)
+{
+	if (!IsValidCoord(Coord)) return false;
+
+	EKernelCellType& Cell = Cells[CoordToIndex(Coord)];
+	const int32 Word = Coord.X >> 6;
+	const uint64 Bit = 1ull << (Coord.X & 63);
+	GetTypeRow(Cell, Coord.Y)[Word] &= ~Bit;
+	GetTypeRow(CellType, Coord.Y)[Word] |= Bit;
+
+	const int32 Delta = (CellType != FreeType ? 1 : 0) - (Cell != FreeType ? 1 : 0);
+	Cell = CellType;
+	if (Delta != 0) bBlockedSumsDirty = true;
+
+	// Freed cells can merge rectangles, so only blocking is applied incrementally
+	if (Delta > 0 && !bFreeRectsDirty) SplitFreeRects(FIntRect(Coord.X, Coord.Y, Coord.X + 1, Coord.Y + 1));
+	else if (Delta < 0) bFreeRectsDirty = true;
+	return true;
+}
+
+int32 FRoomGenerationKernel::ReplaceCells(EKernelCellType From, EKernelCellType To)
+{
+	int32 Replaced = 0;
+	for (EKernelCellType& Cell : Cells)
+	{
+		if (Cell == From) { Cell = To; ++Replaced; }
+	}
+	if (Replaced > 0) { RebuildTypeBits(); bBlockedSumsDirty = true; bFreeRectsDirty = true; }
+	return Replaced;
+}
+
+int32 FRoomGenerationKernel::CountCells(EKernelCellType CellType) const
+{
+	if (Cells.Num() == 0) return 0;
+
+	int32 Count = 0;
+	const uint64* Words = GetTypeRow(CellType, 0);
+	for (int32 WordIndex = 0; WordIndex < GridSize.Y * WordsPerRow; ++WordIndex)
+	{
+		Count += FMath::CountBits(Words[WordIndex]);
+	}
+	return Count;
+}
+
+int32 FRoomGenerationKernel::MergeCellRects(EKernelCellType CellType, TArray<FIntRect>& OutRects) const
+{
+	if (Cells.Num() == 0) return 0;
+
+	// Work on a copy of the type rows, bits are cleared once a rectangle covers them
+	FMemMark ScratchMark(FMemStack::Get());
+	TKernelScratchArray<uint64> Remaining;
+	Remaining.Append(GetTypeRow(CellType, 0), GridSize.Y * WordsPerRow);
+
+	const int32 StartCount = OutRects.Num();
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		uint64* Row = Remaining.GetData() + Y * WordsPerRow;
+		for (int32 Word = 0; Word < WordsPerRow; ++Word)
+		{
+			while (Row[Word] != 0)
+			{
+				const int32 MinX = Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Row[Word]));
+				int32 MaxX = MinX + 1;
+				while (MaxX < GridSize.X && (Row[MaxX >> 6] & (1ull << (MaxX & 63))) != 0) ++MaxX;
+
+				int32 MaxY = Y + 1;
+				while (MaxY < GridSize.Y && AreRowBitsSet(Remaining.GetData() + MaxY * WordsPerRow, MinX, MaxX)) ++MaxY;
+
+				for (int32 RectY = Y; RectY < MaxY; ++RectY) { ClearRowBits(Remaining.GetData() + RectY * WordsPerRow, MinX, MaxX); }
+				OutRects.Add(FIntRect(MinX, Y, MaxX, MaxY));
+			}
+		}
+	}
+	return OutRects.Num() - StartCount;
+}
+
+int32 FRoomGenerationKernel::CountBlockedCells(FIntPoint StartCoord, FIntPoint Size) const
+{
+	EnsureBlockedSums();
+
+	const int32 MaxX = StartCoord.X + Size.X;
+	const int32 MaxY = StartCoord.Y + Size.Y;
+	return GetBlockedSum(MaxX, MaxY) - GetBlockedSum(StartCoord.X, MaxY) - GetBlockedSum(MaxX, StartCoord.Y) + GetBlockedSum(StartCoord.X, StartCoord.Y);
+}
+
+bool FRoomGenerationKernel::IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size, EKernelCellType RequiredType) const
+{
+	// Entire area must fit within grid
+	if (!IsValidCoord(StartCoord)) return false;
+	if (StartCoord.X + Size.X > GridSize.X || StartCoord.Y + Size.Y > GridSize.Y) return false;
+
+	// O(1) for the free type, the common case in every fill pass
+	if (RequiredType == FreeType) return CountBlockedCells(StartCoord, Size) == 0;
+
+	// One masked compare per row word instead of one compare per cell
+	for (int32 Y = StartCoord.Y; Y < StartCoord.Y + Size.Y; ++Y)
+	{
+		if (!AreRowBitsSet(GetTypeRow(RequiredType, Y), StartCoord.X, StartCoord.X + Size.X)) return false;
+	}
+	return true;
+}
+
+void FRoomGenerationKernel::MarkArea(FIntPoint StartCoord, FIntPoint Size, EKernelCellType CellType)
+{
+	// Clip to grid
+	const int32 MinX = FMath::Max(StartCoord.X, 0);
+	const int32 MinY = FMath::Max(StartCoord.Y, 0);
+	const int32 MaxX = FMath::Min(StartCoord.X + Size.X, GridSize.X);
+	const int32 MaxY = FMath::Min(StartCoord.Y + Size.Y, GridSize.Y);
+
+	if (MinX >= MaxX || MinY >= MaxY) return;
+
+	// Count from the free-type bitboard so marking never forces a summed-area rebuild
+	const int32 Area = (MaxX - MinX) * (MaxY - MinY);
+	int32 OldFree = 0;
+	for (int32 Y = MinY; Y < MaxY; ++Y) { OldFree += CountRowBits(GetTypeRow(FreeType, Y), MinX, MaxX); }
+	const int32 OldBlocked = Area - OldFree;
+	const int32 NewBlocked = CellType != FreeType ? Area : 0;
+
+	for (int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		EKernelCellType* Row = Cells.GetData() + Y * GridSize.X;
+		for (int32 X = MinX; X < MaxX; ++X) { Row[X] = CellType; }
+
+		for (int32 TypeIndex = 0; TypeIndex < NumCellTypes; ++TypeIndex)
+		{
+			const EKernelCellType Type = static_cast<EKernelCellType>(TypeIndex);
+			if (Type == CellType) SetRowBits(GetTypeRow(Type, Y), MinX, MaxX);
+			else ClearRowBits(GetTypeRow(Type, Y), MinX, MaxX);
+		}
+	}
+
+	if (NewBlocked != OldBlocked) bBlockedSumsDirty = true;
+
+	// Freed cells can merge rectangles, so only blocking is applied incrementally
+	if (NewBlocked == 0 && OldBlocked > 0) bFreeRectsDirty = true;
+	else if (NewBlocked > 0 && OldBlocked < Area && !bFreeRectsDirty) SplitFreeRects(FIntRect(MinX, MinY, MaxX, MaxY));
+}
+
+bool FRoomGenerationKernel::TryPlaceArea(FIntPoint StartCoord, FIntPoint Size, EKernelCellType RequiredType, EKernelCellType PlacedType)
+{
+	if (!IsAreaAvailable(StartCoord, Size, RequiredType)) return false;
+	MarkArea(StartCoord, Size, PlacedType);
+	return true;
+}
+#pragma endregion
+
+#pragma region Bitboards
+void FRoomGenerationKernel::RebuildTypeBits()
+{
+	TypeBits.Init(0, NumCellTypes * GridSize.Y * WordsPerRow);
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			GetTypeRow(Cells[Y * GridSize.X + X], Y)[X >> 6] |= 1ull << (X & 63);
+		}
+	}
+}
+
+bool FRoomGenerationKernel::AreRowBitsSet(const uint64* Row, int32 MinX, int32 MaxX)
+{
+	for (int32 X = MinX; X < MaxX;)
+	{
+		const int32 Bit = X & 63;
+		const int32 Count = FMath::Min(64 - Bit, MaxX - X);
+		const uint64 Mask = WordRangeMask(Bit, Count);
+		if ((Row[X >> 6] & Mask) != Mask) return false;
+		X += Count;
+	}
+	return true;
+}
+
+void FRoomGenerationKernel::SetRowBits(uint64* Row, int32 MinX, int32 MaxX)
+{
+	for (int32 X = MinX; X < MaxX;)
+	{
+		const int32 Bit = X & 63;
+		const int32 Count = FMath::Min(64 - Bit, MaxX - X);
+		Row[X >> 6] |= WordRangeMask(Bit, Count);
+		X += Count;
+	}
+}
+
+void FRoomGenerationKernel::ClearRowBits(uint64* Row, int32 MinX, int32 MaxX)
+{
+	for (int32 X = MinX; X < MaxX;)
+	{
+		const int32 Bit = X & 63;
+		const int32 Count = FMath::Min(64 - Bit, MaxX - X);
+		Row[X >> 6] &= ~WordRangeMask(Bit, Count);
+		X += Count;
+	}
+}
+
+int32 FRoomGenerationKernel::CountRowBits(const uint64* Row, int32 MinX, int32 MaxX)
+{
+	int32 Total = 0;
+	for (int32 X = MinX; X < MaxX;)
+	{
+		const int32 Bit = X & 63;
+		const int32 Count = FMath::Min(64 - Bit, MaxX - X);
+		Total += static_cast<int32>(FMath::CountBits(Row[X >> 6] & WordRangeMask(Bit, Count)));
+		X += Count;
+	}
+	return Total;
+}
+#pragma endregion
+
+#pragma region Summed-Area Table
+void FRoomGenerationKernel::RebuildBlockedSums() const
+{
+	const int32 Stride = GridSize.X + 1;
+	BlockedSums.Init(0, Stride * (GridSize.Y + 1));
+
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		int32 RowSum = 0;
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			if (Cells[Y * GridSize.X + X] != FreeType) ++RowSum;
+			BlockedSums[(Y + 1) * Stride + X + 1] = BlockedSums[Y * Stride + X + 1] + RowSum;
+		}
+	}
+	bBlockedSumsDirty = false;
+}
+#pragma endregion
+
+#pragma region Weighted Sampling
+void FKernelAliasTable::Build(TArrayView<const float> Weights)
+{
+	const int32 Count = Weights.Num();
+	Probability.SetNumUninitialized(Count);
+	Alias.SetNumUninitialized(Count);
+	if (Count == 0) return;
+
+	double TotalWeight = 0.0;
+	for (const float Weight : Weights) { TotalWeight += FMath::Max(Weight, 0.0f); }
+
+	// If all weights are zero, select uniformly
+	if (TotalWeight <= 0.0)
+	{
+		for (int32 Index = 0; Index < Count; ++Index) { Probability[Index] = 1.0f; Alias[Index] = Index; }
+		return;
+	}
+
+	// Scale so the average column is 1, then pair each under-full column with an over-full one
+	// Builds also run outside generation stages (pool compiles), so they bring their own mark
+	FMemMark ScratchMark(FMemStack::Get());
+	TKernelScratchArray<double> Scaled;
+	TKernelScratchArray<int32> Small;
+	TKernelScratchArray<int32> Large;
+	Scaled.SetNumUninitialized(Count);
+	Small.Reserve(Count);
+	Large.Reserve(Count);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Scaled[Index] = FMath::Max(Weights[Index], 0.0f) * Count / TotalWeight;
+		(Scaled[Index] < 1.0 ? Small : Large).Add(Index);
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+
+		Probability[Less] = static_cast<float>(Scaled[Less]);
+		Alias[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		(Scaled[More] < 1.0 ? Small : Large).Add(More);
+	}
+
+	// Leftovers are full columns (Small can only be non-empty through rounding)
+	for (const int32 Index : Large) { Probability[Index] = 1.0f; Alias[Index] = Index; }
+	for (const int32 Index : Small) { Probability[Index] = 1.0f; Alias[Index] = Index; }
+}
+
+void FKernelTilePool::Build(TArray<FKernelTileDesc>&& InDescs)
+{
+	Descs = MoveTemp(InDescs);
+	Buckets.Reset();
+
+	// A tile serves its own footprint and the swapped one (rotated 90°)
+	for (int32 TileIndex = 0; TileIndex < Descs.Num(); ++TileIndex)
+	{
+		const FIntPoint Footprint = Descs[TileIndex].Footprint;
+		Buckets.FindOrAdd(Footprint).Candidates.Add(TileIndex);
+		if (Footprint.X != Footprint.Y) Buckets.FindOrAdd(FIntPoint(Footprint.Y, Footprint.X)).Candidates.Add(TileIndex);
+	}
+
+	TArray<float> Weights;
+	for (TPair<FIntPoint, FKernelTileBucket>& Pair : Buckets)
+	{
+		FKernelTileBucket& Bucket = Pair.Value;
+		Weights.Reset(Bucket.Candidates.Num());
+		for (const int32 TileIndex : Bucket.Candidates) { Weights.Add(Descs[TileIndex].Weight); }
+		Bucket.Table.Build(Weights);
+	}
+}
+
+void FKernelWallModuleTable::Build(TArray<FKernelWallModuleDesc>&& InDescs)
+{
+	Descs = MoveTemp(InDescs);
+	Footprints.Reset();
+	Buckets.Reset();
+
+	int32 MaxFootprint = 0;
+	bool bAnyWeight = false;
+	for (const FKernelWallModuleDesc& Desc : Descs)
+	{
+		MaxFootprint = FMath::Max(MaxFootprint, Desc.Footprint);
+		bAnyWeight |= Desc.Weight > 0.0f;
+	}
+	Buckets.SetNum(MaxFootprint + 1);
+
+	// With any positive weight around, zero-weight modules are disabled rather than sampled uniformly
+	for (int32 DescIndex = 0; DescIndex < Descs.Num(); ++DescIndex)
+	{
+		const FKernelWallModuleDesc& Desc = Descs[DescIndex];
+		if (Desc.Footprint < 1 || (bAnyWeight && Desc.Weight <= 0.0f)) continue;
+		Buckets[Desc.Footprint].Candidates.Add(DescIndex);
+	}
+
+	TArray<float> Weights;
+	for (int32 Footprint = MaxFootprint; Footprint >= 1; --Footprint)
+	{
+		FKernelWallBucket& Bucket = Buckets[Footprint];
+		if (Bucket.Candidates.Num() == 0) continue;
+
+		Weights.Reset(Bucket.Candidates.Num());
+		for (const int32 DescIndex : Bucket.Candidates) { Weights.Add(Descs[DescIndex].Weight); }
+		Bucket.Table.Build(Weights);
+		Footprints.Add(Footprint);
+	}
+}
+
+int32 FKernelWallModuleTable::SampleModule(int32 Footprint, FRandomStream& Stream) const
+{
+	if (!Buckets.IsValidIndex(Footprint)) return INDEX_NONE;
+
+	const FKernelWallBucket& Bucket = Buckets[Footprint];
+	const int32 Pick = Bucket.Table.Sample(Stream);
+	return Pick == INDEX_NONE ? INDEX_NONE : Descs[Bucket.Candidates[Pick]].ModuleId;
+}
+#pragma endregion
+
+#pragma region Free Rectangle Index
+bool FRoomGenerationKernel::CanFitFreeArea(FIntPoint Size)
+{
+	EnsureFreeRects();
+	for (const FIntRect& Free : FreeRects)
+	{
+		if (Free.Width() >= Size.X && Free.Height() >= Size.Y) return true;
+	}
+	return false;
+}
+
+void FRoomGenerationKernel::EnsureFreeRects()
+{
+	if (!bFreeRectsDirty) return;
+
+	// Start from the whole grid and carve out each row run of blocked cells
+	FreeRects.Reset();
+	if (GridSize.X > 0 && GridSize.Y > 0) FreeRects.Add(FIntRect(0, 0, GridSize.X, GridSize.Y));
+
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		int32 X = 0;
+		while (X < GridSize.X)
+		{
+			if (Cells[Y * GridSize.X + X] == FreeType) { ++X; continue; }
+
+			const int32 RunStart = X;
+			while (X < GridSize.X && Cells[Y * GridSize.X + X] != FreeType) { ++X; }
+			SplitFreeRects(FIntRect(RunStart, Y, X, Y + 1));
+		}
+	}
+
+	bFreeRectsDirty = false;
+}
+
+void FRoomGenerationKernel::SplitFreeRects(const FIntRect& Used)
+{
+	// Leftovers of the rectangles Used overlaps; the untouched rectangles are already maximal among themselves
+	TArray<FIntRect, TInlineAllocator<16>> SplitRects;
+	for (int32 RectIndex = FreeRects.Num() - 1; RectIndex >= 0; --RectIndex)
+	{
+		const FIntRect Free = FreeRects[RectIndex];
+		if (Used.Min.X >= Free.Max.X || Used.Max.X <= Free.Min.X || Used.Min.Y >= Free.Max.Y || Used.Max.Y <= Free.Min.Y) continue;
+
+		FreeRects.RemoveAtSwap(RectIndex);
+
+		// Up to four maximal leftovers: left, right, bottom, top strips
+		if (Used.Min.X > Free.Min.X) SplitRects.Add(FIntRect(Free.Min.X, Free.Min.Y, Used.Min.X, Free.Max.Y));
+		if (Used.Max.X < Free.Max.X) SplitRects.Add(FIntRect(Used.Max.X, Free.Min.Y, Free.Max.X, Free.Max.Y));
+		if (Used.Min.Y > Free.Min.Y) SplitRects.Add(FIntRect(Free.Min.X, Free.Min.Y, Free.Max.X, Used.Min.Y));
+		if (Used.Max.Y < Free.Max.Y) SplitRects.Add(FIntRect(Free.Min.X, Used.Max.Y, Free.Max.X, Free.Max.Y));
+	}
+
+	// A leftover lies inside the rectangle it came from, so an untouched rectangle can never be contained in one:
+	// only the leftovers need pruning, against the untouched set and each other (keep the first of identical pairs)
+	auto Contains = [](const FIntRect& Outer, const FIntRect& Inner)
+	{
+		return Inner.Min.X >= Outer.Min.X && Inner.Min.Y >= Outer.Min.Y && Inner.Max.X <= Outer.Max.X && Inner.Max.Y <= Outer.Max.Y;
+	};
+
+	const int32 NumUntouched = FreeRects.Num();
+	for (int32 SplitIndex = 0; SplitIndex < SplitRects.Num(); ++SplitIndex)
+	{
+		const FIntRect& Candidate = SplitRects[SplitIndex];
+		bool bContained = false;
+
+		for (int32 RectIndex = 0; RectIndex < NumUntouched && !bContained; ++RectIndex)
+		{
+			bContained = Contains(FreeRects[RectIndex], Candidate);
+		}
+		for (int32 OtherIndex = 0; OtherIndex < SplitRects.Num() && !bContained; ++OtherIndex)
+		{
+			if (OtherIndex == SplitIndex || !Contains(SplitRects[OtherIndex], Candidate)) continue;
+			bContained = SplitRects[OtherIndex] != Candidate || OtherIndex < SplitIndex;
+		}
+
+		if (!bContained) FreeRects.Add(Candidate);
+	}
+}
+
+bool FRoomGenerationKernel::FindNextFreeOrigin(FIntPoint Size, FIntPoint From, FIntPoint& OutOrigin) const
+{
+	// Every valid origin lies inside some maximal free rectangle, so the earliest one at or after From
+	// is the minimum over rectangles of their own earliest origin
+	bool bFound = false;
+	for (const FIntRect& Free : FreeRects)
+	{
+		const int32 LastX = Free.Max.X - Size.X;
+		const int32 LastY = Free.Max.Y - Size.Y;
+		if (LastX < Free.Min.X || LastY < Free.Min.Y) continue;
+
+		FIntPoint Candidate;
+		if (From.Y < Free.Min.Y) Candidate = Free.Min;
+		else if (From.Y > LastY) continue;
+		else if (FMath::Max(From.X, Free.Min.X) <= LastX) Candidate = FIntPoint(FMath::Max(From.X, Free.Min.X), From.Y);
+		else if (From.Y < LastY) Candidate = FIntPoint(Free.Min.X, From.Y + 1);
+		else continue;
+
+		if (!bFound || Candidate.Y < OutOrigin.Y || (Candidate.Y == OutOrigin.Y && Candidate.X < OutOrigin.X))
+		{
+			OutOrigin = Candidate;
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+#pragma endregion
+
+#pragma region Fill Algorithms
+int32 FRoomGenerationKernel::FillWithTileSize(const FKernelTilePool& TilePool, FIntPoint TargetSize,
+	EKernelCellType AvailableType, EKernelCellType PlacedType, FRandomStream& Stream, TKernelScratchArray<FKernelTilePlacement>& OutPlacements)
+{
+	// Tiles that match target size (or rotated version), precompiled with their sampling table
+	const FKernelTileBucket* Bucket = TilePool.FindBucket(TargetSize);
+	if (!Bucket) return 0; // No tiles of this size
+
+	const TArray<FKernelTileDesc>& Descs = TilePool.GetDescs();
+	int32 PlacedCount = 0;
+
+	auto PlaceTileAt = [&](const FIntPoint& StartCoord)
+	{
+		const FKernelTileDesc& Tile = Descs[Bucket->Candidates[Bucket->Table.Sample(Stream)]];
+		MarkArea(StartCoord, TargetSize, PlacedType);
+
+		FKernelTilePlacement& Placement = OutPlacements.AddDefaulted_GetRef();
+		Placement.Position = StartCoord;
+		Placement.Footprint = TargetSize;
+		Placement.Rotation = PickRotationForSize(Tile, TargetSize, Stream);
+		Placement.MeshId = Tile.MeshId;
+		++PlacedCount;
+	};
+
+	// Free-type fills: visit only origins the rectangle index reports, in scan order
+	if (AvailableType == FreeType)
+	{
+		if (!CanFitFreeArea(TargetSize)) return 0; // Nothing of this size left
+
+		FIntPoint StartCoord;
+		FIntPoint From(0, 0);
+		while (FindNextFreeOrigin(TargetSize, From, StartCoord))
+		{
+			PlaceTileAt(StartCoord);
+			From = FIntPoint(StartCoord.X + 1, StartCoord.Y);
+		}
+		return PlacedCount;
+	}
+
+	// Try to place tiles of this size across the grid
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			const FIntPoint StartCoord(X, Y);
+			if (IsAreaAvailable(StartCoord, TargetSize, AvailableType)) PlaceTileAt(StartCoord);
+		}
+	}
+
+	return PlacedCount;
+}
+
+int32 FRoomGenerationKernel::FillRemainingGaps(const FKernelTilePool& TilePool, EKernelCellType AvailableType,
+	EKernelCellType PlacedType, FRandomStream& Stream, TKernelScratchArray<FKernelTilePlacement>& OutPlacements)
+{
+	int32 PlacedCount = 0;
+	for (const FIntPoint& TargetSize : GapFillSizes)
+	{
+		PlacedCount += FillWithTileSize(TilePool, TargetSize, AvailableType, PlacedType, Stream, OutPlacements);
+	}
+	return PlacedCount;
+}
+
+void FRoomGenerationKernel::PackWallRun(int32 RunLength, const FKernelWallModuleTable& Modules,
+	TFunctionRef<bool(int32)> IsCellBlocked, FRandomStream& Stream, TKernelScratchArray<FKernelWallSpan>& OutSpans)
+{
+	const TArray<int32>& Footprints = Modules.GetFootprints();
+	if (Footprints.Num() == 0 || RunLength <= 0) return;
+
+	// Suffix DP tables for one open stretch: best fill of [i, StretchEnd), Choice = footprint placed at i (0 = leave open)
+	TKernelScratchArray<int32> Covered, Count, Choice;
+
+	int32 StretchStart = 0;
+	while (StretchStart < RunLength)
+	{
+		// Blocked cells stay open
+		if (IsCellBlocked(StretchStart)) { ++StretchStart; continue; }
+
+		int32 StretchEnd = StretchStart + 1;
+		while (StretchEnd < RunLength && !IsCellBlocked(StretchEnd)) { ++StretchEnd; }
+		const int32 Length = StretchEnd - StretchStart;
+
+		Covered.SetNumUninitialized(Length + 1);
+		Count.SetNumUninitialized(Length + 1);
+		Choice.SetNumUninitialized(Length + 1);
+		Covered[Length] = 0;
+		Count[Length] = 0;
+		Choice[Length] = 0;
+
+		for (int32 i = Length - 1; i >= 0; --i)
+		{
+			// Leaving cell i open is always possible
+			Covered[i] = Covered[i + 1];
+			Count[i] = Count[i + 1];
+			Choice[i] = 0;
+
+			for (const int32 Footprint : Footprints)
+			{
+				if (i + Footprint > Length) continue;
+
+				const int32 CandidateCovered = Covered[i + Footprint] + Footprint;
+				const int32 CandidateCount = Count[i + Footprint] + 1;
+				if (CandidateCovered > Covered[i] || (CandidateCovered == Covered[i] && CandidateCount < Count[i]))
+				{
+					Covered[i] = CandidateCovered;
+					Count[i] = CandidateCount;
+					Choice[i] = Footprint;
+				}
+			}
+		}
+
+		// Walk the choices front to back
+		for (int32 i = 0; i < Length;)
+		{
+			if (Choice[i] == 0) { ++i; continue; }
+
+			FKernelWallSpan& Span = OutSpans.AddDefaulted_GetRef();
+			Span.StartIndex = StretchStart + i;
+			Span.Length = Choice[i];
+			Span.ModuleId = Modules.SampleModule(Choice[i], Stream);
+			i += Choice[i];
+		}
+
+		StretchStart = StretchEnd;
+	}
+}
+#pragma endregion
+
+#pragma region Descriptor Helpers
+FIntPoint FRoomGenerationKernel::GetRotatedFootprint(FIntPoint Footprint, int32 Rotation)
+{
+	// Normalize rotation to 0-359 range
+	Rotation = Rotation % 360;
+	if (Rotation < 0) Rotation += 360;
+
+	// 90° and 270° rotations swap X and Y
+	if (Rotation == 90 || Rotation == 270) return FIntPoint(Footprint.Y, Footprint.X);
+	return Footprint;
+}
+
+uint8 FRoomGenerationKernel::MakeRotationMask(const TArray<int32>& Rotations)
+{
+	uint8 Mask = 0;
+	for (int32 Rotation : Rotations)
+	{
+		Rotation = Rotation % 360;
+		if (Rotation < 0) Rotation += 360;
+		if (Rotation % 90 == 0) Mask |= 1 << (Rotation / 90);
+	}
+	return Mask;
+}
+
+int32 FRoomGenerationKernel::PickRotationForSize(const FKernelTileDesc& Tile, FIntPoint TargetSize, FRandomStream& Stream)
+{
+	// Rotations that would fit the target size
+	int32 ValidRotations[4];
+	int32 NumValid = 0;
+
+	for (int32 QuarterTurn = 0; QuarterTurn < 4; ++QuarterTurn)
+	{
+		if (!(Tile.RotationMask & (1 << QuarterTurn))) continue;
+		if (GetRotatedFootprint(Tile.Footprint, QuarterTurn * 90) == TargetSize) ValidRotations[NumValid++] = QuarterTurn * 90;
+	}
+
+	if (NumValid == 0) return 0;
+	return ValidRotations[Stream.RandRange(0, NumValid - 1)];
+}
+#pragma endregion
@@ -6,10 +6,11 @@
 #include "Utilities/Generation/RoomGenerationHelpers.h" 
 #include "Data/Grid/GridData.h"
 #include "Data/Room/CeilingData.h"
+#include "Misc/ScopeLock.h"
 #include "Data/Room/DoorData.h"
 #include "Data/Room/WallData.h"
 
-bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize)
+bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize, int32 InRoomSeed)
 {
 	if (!InRoomData)
 	{
@@ -20,6 +21,8 @@ bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize)
 	RoomData = InRoomData;
 	GridSize = InGridSize;
 	CellSize = CELL_SIZE;
+	RoomSeed = (InRoomSeed == -1) ? FMath::Rand() : InRoomSeed;
+	for (FRandomStream& Stream : StageStreams) Stream.Initialize(RoomSeed);
 	bIsInitialized = true;
 
 	// Initialize statistics
@@ -28,21 +31,66 @@ bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize)
 	SmallTilesPlaced = 0;
 	FillerTilesPlaced = 0;
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::Initialize - Initialized with GridSize (%d, %d), CellSize %.2f"), 
-	GridSize.X, GridSize.Y, CellSize);
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::Initialize - Initialized with GridSize (%d, %d), CellSize %.2f, Seed %d"), 
+	GridSize.X, GridSize.Y, CellSize, RoomSeed);
 	return true;
 }
 
+FRandomStream URoomGenerator::MakeStageStream(ERoomRandomStage Stage) const
+{
+	return FRandomStream(static_cast<int32>(HashCombine(GetTypeHash(RoomSeed), GetTypeHash(static_cast<uint32>(Stage)))));
+}
+
+FRandomStream& URoomGenerator::BeginRandomStage(ERoomRandomStage Stage)
+{
+	FRandomStream& Stream = StageStreams[static_cast<int32>(Stage)];
+	Stream = MakeStageStream(Stage);
+	return Stream;
+}
+
+#pragma region Stage Graph
+void URoomGenerator::BuildStageGraph(FRoomStageGraph& Graph) const
+{
+	using EAccess = ERoomStageAccess;
+
+	// Floor and walls are required, the remaining stages are optional for a room
+	Graph.AddStage(TEXT("Floor"), EAccess::None, EAccess::GridCells | EAccess::FloorPlacements, true,
+		[](URoomGenerator& Generator) { return Generator.GenerateFloor(); });
+
+	// Walls generate the doorways first (which marks doorway cells)
+	Graph.AddStage(TEXT("Walls"), EAccess::None, EAccess::GridCells | EAccess::WallPlacements | EAccess::DoorwayLayout, true,
+		[](URoomGenerator& Generator) { return Generator.GenerateWalls(); });
+
+	// Corners follow the room outline and load WallData
+	Graph.AddStage(TEXT("Corners"), EAccess::GridCells, EAccess::CornerPlacements | EAccess::WallPlacements, false,
+		[](URoomGenerator& Generator) { return Generator.GenerateCorners(); });
+
+	Graph.AddStage(TEXT("Doorways"), EAccess::None, EAccess::GridCells | EAccess::DoorwayLayout, false,
+		[](URoomGenerator& Generator) { return Generator.GenerateDoorways(); });
+
+	// Ceiling fills its own CeilingKernel
+	Graph.AddStage(TEXT("Ceiling"), EAccess::None, EAccess::CeilingPlacements, false,
+		[](URoomGenerator& Generator) { return Generator.GenerateCeiling(); });
+}
+#pragma endregion
+
 #pragma region Room Grid Management
 void URoomGenerator:: ClearGrid()
 {
-	GridState.Empty();
+	GridKernel.Empty();
+	CeilingKernel.Empty();
 	PlacedFloorMeshes.Empty();
 	PlacedWallMeshes.Empty();
-	PlacedBaseWallSegments.Empty();
+	ResetBaseWallSegments();
 	PlacedDoorwayMeshes.Empty();
+	for (TBitArray<>& EdgeBits : DoorwayEdgeBits) EdgeBits.Empty();
 	PlacedCornerMeshes.Empty();
 	PlacedCeilingTiles.Empty();
+	PlacementQueue.Empty();
+	PlacedMeshPalette.Empty();
+	MeshPaletteLookup.Empty();
+	PlacedWallModulePalette.Empty();
+	WallModulePaletteLookup.Empty();
 
 	// Reset statistics
 	LargeTilesPlaced = 0;
@@ -61,33 +109,34 @@ void URoomGenerator::ResetGridCellStates()
 	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::ResetGridCellStates - Not initialized! ")); return; }
 
 	// Reset only floor-placed cells back to their target type (preserves room shape)
-	int32 CellsReset = 0;
-	for (EGridCellType& Cell : GridState)
-	{
-		// ✅ Only reset cells that were filled with floor meshes
-		if (Cell == EGridCellType::ECT_FloorMesh)
-		{
-			Cell = FloorTargetCellType;  // Back to Empty (Uniform) or Custom (Chunky)
-			CellsReset++;
-		}
-	}
+	// ✅ Back to Empty (Uniform) or Custom (Chunky)
+	int32 CellsReset = GridKernel.ReplaceCells(EKernelCellType::ECT_FloorMesh, ToKernelCell(FloorTargetCellType));
 
 	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ResetGridCellStates - Reset %d cells to empty (Total: %d)"), 
-		CellsReset, GridState.Num());
+		CellsReset, GridKernel.GetCells().Num());
+}
+
+TArray<EGridCellType> URoomGenerator::GetGridState() const
+{
+	const TArray<EKernelCellType>& KernelCells = GridKernel.GetCells();
+
+	TArray<EGridCellType> GridState;
+	GridState.Reserve(KernelCells.Num());
+	for (EKernelCellType Cell : KernelCells)
+	{
+		GridState.Add(ToGridCell(Cell));
+	}
+	return GridState;
 }
 
 EGridCellType URoomGenerator:: GetCellState(FIntPoint GridCoord) const
 {
-	if (!IsValidGridCoordinate(GridCoord)) return EGridCellType::ECT_Empty;
-	int32 Index = GridCoordToIndex(GridCoord); return GridState[Index];
+	return ToGridCell(GridKernel.GetCell(GridCoord));
 }
 
 bool URoomGenerator::SetCellState(FIntPoint GridCoord, EGridCellType NewState)
 {
-	if (!IsValidGridCoordinate(GridCoord))	return false;
-
-	int32 Index = GridCoordToIndex(GridCoord);
-	GridState[Index] = NewState; return true;
+	return GridKernel.SetCell(GridCoord, ToKernelCell(NewState));
 }
 
 bool URoomGenerator::IsValidGridCoordinate(FIntPoint GridCoord) const
@@ -97,17 +146,12 @@ bool URoomGenerator::IsValidGridCoordinate(FIntPoint GridCoord) const
 
 bool URoomGenerator::IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size) const
 {
-	// Delegate to static helper
-	return URoomGenerationHelpers::IsAreaAvailable(GridState, GridSize, StartCoord, Size, FloorTargetCellType);
+	return GridKernel.IsAreaAvailable(StartCoord, Size, ToKernelCell(FloorTargetCellType));
 }
 
 bool URoomGenerator::MarkArea(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType)
 {
-	// Check availability using helper
-	if (!URoomGenerationHelpers::IsAreaAvailable(GridState, GridSize, StartCoord, Size, EGridCellType::ECT_Empty)) return false;
-
-	// Mark cells using helper
-	URoomGenerationHelpers:: MarkCellsOccupied(GridState, GridSize, StartCoord, Size, CellType); return true;
+	return GridKernel.TryPlaceArea(StartCoord, Size, EKernelCellType::ECT_Empty, ToKernelCell(CellType));
 }
 
 bool URoomGenerator::ClearArea(FIntPoint StartCoord, FIntPoint Size)
@@ -115,8 +159,7 @@ bool URoomGenerator::ClearArea(FIntPoint StartCoord, FIntPoint Size)
 	// Validate coordinates
 	if (StartCoord.X + Size.X > GridSize.X || StartCoord. Y + Size.Y > GridSize.Y) return false;
 
-	// Use helper to clear (mark as Empty)
-	URoomGenerationHelpers::MarkCellsOccupied(GridState, GridSize, StartCoord, Size, EGridCellType:: ECT_Empty); 
+	GridKernel.MarkArea(StartCoord, Size, EKernelCellType::ECT_Empty);
 	return true;
 }
 
@@ -247,109 +290,26 @@ int32 URoomGenerator::ExecuteForcedPlacements()
 }
 
 int32 URoomGenerator::FillRemainingGaps(const TArray<FMeshPlacementInfo>& TilePool,
+	const FKernelTilePool& CompiledPool,
+	FRandomStream& Stream,
 	int32& OutLargeTiles,
 	int32& OutMediumTiles,
 	int32& OutSmallTiles,
 	int32& OutFillerTiles)
 {
-if (TilePool.Num() == 0)
+	if (TilePool.Num() == 0)
 	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator:: FillRemainingGaps - No meshes in tile pool! ")); return 0;}
 
-	int32 PlacedCount = 0;
-
-	// Define sizes to try (largest to smallest for efficiency)
-	TArray<FIntPoint> SizesToTry = {
-		FIntPoint(1, 4), // 100x400
-		FIntPoint(4, 1), // 400x100
-		FIntPoint(1, 2), // 100x200
-		FIntPoint(2, 1), // 200x100
-		FIntPoint(1, 1)  // 100x100
-	};
-
 	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::FillRemainingGaps - Starting gap fill"));
 
-	// Try each size in order
-	for (const FIntPoint& TargetSize : SizesToTry)
-	{
-		// Filter tiles that match this size
-		TArray<FMeshPlacementInfo> MatchingTiles;
+	// Kernel tries 1x4, 4x1, 1x2, 2x1, 1x1 in order
+	TKernelScratchArray<FKernelTilePlacement> Placements;
+	int32 PlacedCount = GridKernel.FillRemainingGaps(CompiledPool, ToKernelCell(FloorTargetCellType), EKernelCellType::ECT_FloorMesh, Stream, Placements);
 
-		for (const FMeshPlacementInfo& MeshInfo : TilePool)
-		{
-			FIntPoint Footprint = CalculateFootprint(MeshInfo);
-
-			// Check if footprint matches target size (or rotated version)
-			if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) || (Footprint.X == TargetSize.Y && Footprint. Y == TargetSize.X))
-			{
-				MatchingTiles.Add(MeshInfo);
-			}
-		}
-
-		if (MatchingTiles.Num() == 0) continue; // No tiles of this size, try next
-
-		int32 SizePlacedCount = 0;
-
-		// Try to place tiles of this size in all empty spaces
-		for (int32 Y = 0; Y < GridSize.Y; ++Y)
-		{
-			for (int32 X = 0; X < GridSize.X; ++X)
-			{
-				FIntPoint StartCoord(X, Y);
-
-				// Check if area is available
-				if (IsAreaAvailable(StartCoord, TargetSize))
-				{
-					// Select weighted random mesh
-					FMeshPlacementInfo SelectedMesh = SelectWeightedMesh(MatchingTiles);
-					FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
-
-					// Find rotation that matches target size
-					int32 BestRotation = 0;
-					
-					if (SelectedMesh.AllowedRotations.Num() > 0)
-					{
-						// Build list of rotations that would fit the target size
-						TArray<int32> ValidRotations;
-
-						for (int32 Rotation : SelectedMesh.AllowedRotations)
-						{
-							FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-							
-							if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-							{
-								ValidRotations.Add(Rotation);
-							}
-						}
-
-						// Select random rotation from valid options
-						if (ValidRotations.Num() > 0)
-						{
-							int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-							BestRotation = ValidRotations[RandomIndex];
-						}
-					}
-
-					// Try to place mesh with rotation
-					if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
-					{
-						SizePlacedCount++;
-						PlacedCount++;
-
-						// Update statistics
-						int32 TileArea = TargetSize.X * TargetSize.Y;
-						if (TileArea >= 16) OutLargeTiles++;
-						else if (TileArea >= 4) OutMediumTiles++;
-						else if (TileArea >= 2) OutSmallTiles++;
-						else OutFillerTiles++;
-					}
-				}
-			}
-		}
-
-		if (SizePlacedCount > 0)
-		{
-			UE_LOG(LogTemp, Verbose, TEXT("  Filled %d gaps with %dx%d tiles"), SizePlacedCount, TargetSize. X, TargetSize.Y);
-		}
+	for (const FKernelTilePlacement& Placement : Placements)
+	{
+		RecordFloorPlacement(Placement.Position, Placement.Footprint, TilePool[Placement.MeshId], Placement.Rotation);
+		AddTileStatistics(Placement.Footprint, 1, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::FillRemainingGaps - Placed %d gap-fill meshes"), PlacedCount);
@@ -357,59 +317,74 @@ if (TilePool.Num() == 0)
 	return PlacedCount;
 }
 
+FIntRect URoomGenerator::GetForcedEmptyRegionRect(const FForcedEmptyRegion& Region) const
+{
+	// Bounding box handles any corner order, clamped to the grid (Max exclusive, empty when fully outside)
+	const int32 MinX = FMath::Max(FMath::Min(Region.StartCell.X, Region.EndCell.X), 0);
+	const int32 MinY = FMath::Max(FMath::Min(Region.StartCell.Y, Region.EndCell.Y), 0);
+	const int32 MaxX = FMath::Min(FMath::Max(Region.StartCell.X, Region.EndCell.X) + 1, GridSize.X);
+	const int32 MaxY = FMath::Min(FMath::Max(Region.StartCell.Y, Region.EndCell.Y) + 1, GridSize.Y);
+
+	return FIntRect(MinX, MinY, FMath::Max(MaxX, MinX), FMath::Max(MaxY, MinY));
+}
+
 TArray<FIntPoint> URoomGenerator::ExpandForcedEmptyRegions() const
 {
 	TArray<FIntPoint> ExpandedCells;
 
 	if (! RoomData) return ExpandedCells;
 
+	// Bit per grid cell keeps overlapping regions and cells unique without a linear search
+	TBitArray<> Seen(false, GridSize.X * GridSize.Y);
+	auto AddCell = [&](FIntPoint Cell)
+	{
+		const int32 Index = Cell.Y * GridSize.X + Cell.X;
+		if (!Seen[Index]) { Seen[Index] = true; ExpandedCells.Add(Cell); }
+	};
+
 	// 1. Expand all rectangular regions into individual cells
 	for (const FForcedEmptyRegion& Region : RoomData->ForcedEmptyRegions)
 	{
-		// Calculate bounding box (handles any corner order)
-		int32 MinX = FMath::Min(Region.StartCell.X, Region.EndCell. X);
-		int32 MaxX = FMath::Max(Region.StartCell.X, Region.EndCell.X);
-		int32 MinY = FMath::Min(Region.StartCell.Y, Region.EndCell. Y);
-		int32 MaxY = FMath::Max(Region.StartCell.Y, Region.EndCell.Y);
-
-		// Clamp to valid grid bounds
-		MinX = FMath:: Clamp(MinX, 0, GridSize.X - 1);
-		MaxX = FMath::Clamp(MaxX, 0, GridSize.X - 1);
-		MinY = FMath::Clamp(MinY, 0, GridSize.Y - 1);
-		MaxY = FMath:: Clamp(MaxY, 0, GridSize.Y - 1);
-
-		// Add all cells within the rectangular region
-		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		const FIntRect Rect = GetForcedEmptyRegionRect(Region);
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
 		{
-			for (int32 X = MinX; X <= MaxX; ++X)
-			{
-				FIntPoint Cell(X, Y);
-				ExpandedCells.AddUnique(Cell); // AddUnique prevents duplicates
-			}
+			for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X) { AddCell(FIntPoint(X, Y)); }
 		}
 	}
 
 	// 2. Add individual forced empty cells
 	for (const FIntPoint& Cell : RoomData->ForcedEmptyFloorCells)
 	{
-		// Validate cell is within grid bounds
-		if (Cell.X >= 0 && Cell.X < GridSize.X && Cell.Y >= 0 && Cell.Y < GridSize.Y) {	ExpandedCells.AddUnique(Cell); }
+		if (IsValidGridCoordinate(Cell)) { AddCell(Cell); }
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator:: ExpandForcedEmptyRegions - Expanded to %d cells"), ExpandedCells.Num());
-
 	return ExpandedCells;
 }
 
-void URoomGenerator::MarkForcedEmptyCells(const TArray<FIntPoint>& EmptyCells)
+int32 URoomGenerator::MarkForcedEmptyRegions()
 {
-	for (const FIntPoint& Cell :  EmptyCells)
+	if (!RoomData) return 0;
+
+	// Marked as Wall type (reserved/boundary marker); counted by the bitboard delta so overlaps aren't double counted
+	const int32 ReservedBefore = GridKernel.CountCells(EKernelCellType::ECT_WallMesh);
+
+	// Regions go in as clamped rectangles (one row span per row), never as per-cell lists
+	for (const FForcedEmptyRegion& Region : RoomData->ForcedEmptyRegions)
+	{
+		const FIntRect Rect = GetForcedEmptyRegionRect(Region);
+		if (Rect.Area() > 0) GridKernel.MarkArea(Rect.Min, Rect.Size(), EKernelCellType::ECT_WallMesh);
+	}
+
+	// SetCell ignores cells outside the grid
+	for (const FIntPoint& Cell : RoomData->ForcedEmptyFloorCells)
 	{
-		// Mark as Wall type (reserved/boundary marker)
-		SetCellState(Cell, EGridCellType::ECT_WallMesh);
+		GridKernel.SetCell(Cell, EKernelCellType::ECT_WallMesh);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::MarkForcedEmptyCells - Marked %d cells as empty"), EmptyCells.Num());
+	const int32 MarkedCount = GridKernel.CountCells(EKernelCellType::ECT_WallMesh) - ReservedBefore;
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::MarkForcedEmptyRegions - Marked %d cells as empty"), MarkedCount);
+
+	return MarkedCount;
 }
 #pragma endregion
 
@@ -437,7 +412,7 @@ int32 URoomGenerator::ExecuteForcedWallPlacements()
 
 	if (RoomData->WallStyleData.IsValid())
 	{
-		WallData = RoomData->WallStyleData.LoadSynchronous();
+		WallData = RoomData->WallStyleData.Get();
 		if (WallData)
 		{
 			NorthOffset = WallData->NorthWallOffsetX;
@@ -468,7 +443,7 @@ int32 URoomGenerator::ExecuteForcedWallPlacements()
 
 	 
 		// VALIDATION: Check Edge Cells
-		TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(ForcedWall.Edge, GridSize);
+		const FEdgeCellView EdgeCells = URoomGenerationHelpers::GetEdgeCellView(ForcedWall.Edge, GridSize);
 
 		if (EdgeCells.Num() == 0)
 		{
@@ -509,7 +484,7 @@ int32 URoomGenerator::ExecuteForcedWallPlacements()
 		Segment.BaseMesh = BaseMesh;
 		Segment.WallModule = &Module;  // Store pointer to module data
 
-		PlacedBaseWallSegments.Add(Segment);
+		AddBaseWallSegment(Segment);
 
 		UE_LOG(LogTemp, Verbose, TEXT("    ✓ Forced wall tracked: Edge=%s, StartCell=%d, Footprint=%d"),
 		*UEnum::GetValueAsString(ForcedWall.Edge), ForcedWall.StartCell, Footprint);
@@ -523,139 +498,116 @@ int32 URoomGenerator::ExecuteForcedWallPlacements()
 
 bool URoomGenerator::IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const
 {
-	// Check if any forced wall overlaps with this range
-	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
-	{
-		if (Segment.Edge != Edge) continue;
+	if (Edge == EWallEdge::None || Length <= 0) return false;
 
-		// Check for overlap:  [Start1, End1) overlaps [Start2, End2) if Start1 < End2 AND Start2 < End1
-		int32 SegmentEnd = Segment.StartCell + Segment.SegmentLength;
-		int32 RangeEnd = StartCell + Length;
+	// First occupied cell at or after the range start decides the overlap
+	const TBitArray<>& EdgeBits = WallOccupancyBits[static_cast<int32>(Edge) - 1];
+	const int32 RangeStart = FMath::Max(StartCell, 0);
+	const int32 RangeEnd = FMath::Min(StartCell + Length, EdgeBits.Num());
+	if (RangeStart >= RangeEnd) return false;
 
-		if (StartCell < SegmentEnd && Segment.StartCell < RangeEnd) return true;  // Overlap detected
-	}
-	return false;
+	const int32 FirstOccupied = EdgeBits.FindFrom(true, RangeStart);
+	return FirstOccupied != INDEX_NONE && FirstOccupied < RangeEnd;
+}
+
+void URoomGenerator::AddBaseWallSegment(const FGeneratorWallSegment& Segment)
+{
+	PlacedBaseWallSegments.Add(Segment);
+	if (Segment.Edge == EWallEdge::None || Segment.StartCell < 0 || Segment.SegmentLength <= 0) return;
+
+	TBitArray<>& EdgeBits = WallOccupancyBits[static_cast<int32>(Segment.Edge) - 1];
+	const int32 SegmentEnd = Segment.StartCell + Segment.SegmentLength;
+	if (EdgeBits.Num() < SegmentEnd) EdgeBits.Add(false, SegmentEnd - EdgeBits.Num());
+	EdgeBits.SetRange(Segment.StartCell, Segment.SegmentLength, true);
+}
+
+void URoomGenerator::ResetBaseWallSegments()
+{
+	PlacedBaseWallSegments.Empty();
+	for (TBitArray<>& EdgeBits : WallOccupancyBits) EdgeBits.Empty();
 }
 
 void URoomGenerator::ClearPlacedWalls()
 {
 	PlacedWallMeshes.Empty();
+
+	// Only wall records index this palette, and module addresses may change between generations
+	PlacedWallModulePalette.Empty();
+	WallModulePaletteLookup.Empty();
 }
 
-void URoomGenerator::SpawnMiddleWallLayers()
+void URoomGenerator::StackWallLayers()
 {
 	if (!RoomData || RoomData->WallStyleData.IsNull()) return;
 
-	// Get fallback height from WallData
-	float FallbackHeight = 100.0f;
-	WallData = RoomData->WallStyleData.LoadSynchronous();
-	if (WallData) { FallbackHeight = WallData->WallHeight;}
+	WallData = RoomData->WallStyleData.Get();
+	if (!WallData)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::StackWallLayers - WallStyleData is not loaded")); return; }
+
+	// Segments share a handful of modules, resolve each module's meshes once
+	struct FWallStackMeshes
+	{
+		UStaticMesh* Middle1 = nullptr;
+		UStaticMesh* Middle2 = nullptr;
+		UStaticMesh* Top = nullptr;
+	};
+	TMap<const FWallModule*, FWallStackMeshes> ModuleMeshes;
 
 	int32 Middle1Spawned = 0;
 	int32 Middle2Spawned = 0;
+	int32 TopSpawned = 0;
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::SpawnMiddleWallLayers - Processing %d base segments"), PlacedBaseWallSegments.Num());
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::StackWallLayers - Processing %d base segments"), PlacedBaseWallSegments.Num());
 
+	PlacedWallMeshes.Reserve(PlacedWallMeshes.Num() + PlacedBaseWallSegments.Num());
 	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
 	{
 		if (!Segment.WallModule) continue;
 
-		// MIDDLE 1 LAYER
-		UStaticMesh* Middle1Mesh = Segment.WallModule->MiddleMesh1.LoadSynchronous();
-
-		if (Middle1Mesh)
+		FWallStackMeshes* Meshes = ModuleMeshes.Find(Segment.WallModule);
+		if (!Meshes)
 		{
-			// ✅ Single line replaces 15+ lines of socket querying
-			FTransform Middle1WorldTransform = URoomGenerationHelpers::CalculateSocketWorldTransform(
-				Segment.BaseMesh,
-				FName("TopBackCenter"),
-				Segment.BaseTransform,
-				FVector(0, 0, FallbackHeight));
-
-			// Store wall info
-			FPlacedWallInfo PlacedWall;
-			PlacedWall.Edge = Segment.Edge;
-			PlacedWall.StartCell = Segment.StartCell;
-			PlacedWall.SpanLength = Segment.SegmentLength;
-			PlacedWall.WallModule = *Segment.WallModule;
-			PlacedWall.BottomTransform = Segment.BaseTransform;
-			PlacedWall.Middle1Transform = Middle1WorldTransform;
-
-			PlacedWallMeshes.Add(PlacedWall);
-			Middle1Spawned++;
-
-			// MIDDLE 2 LAYER
-			UStaticMesh* Middle2Mesh = Segment.WallModule->MiddleMesh2.LoadSynchronous();
-
-			if (Middle2Mesh)
-			{
-				// ✅ Single line replaces 10+ lines of socket querying
-				FTransform Middle2WorldTransform = URoomGenerationHelpers::CalculateSocketWorldTransform(
-				Middle1Mesh, FName("TopBackCenter"), Middle1WorldTransform, FVector(0, 0, FallbackHeight));
-				PlacedWallMeshes.Last().Middle2Transform = Middle2WorldTransform;
-				Middle2Spawned++;
-			}
+			Meshes = &ModuleMeshes.Add(Segment.WallModule);
+			Meshes->Middle1 = URoomGenerationHelpers::LoadAndValidateMesh(Segment.WallModule->MiddleMesh1, TEXT("WallMiddle1"), false);
+			Meshes->Middle2 = URoomGenerationHelpers::LoadAndValidateMesh(Segment.WallModule->MiddleMesh2, TEXT("WallMiddle2"), false);
+			Meshes->Top = URoomGenerationHelpers::LoadAndValidateMesh(Segment.WallModule->TopMesh, TEXT("WallTop"), false);
 		}
-	}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::SpawnMiddleWallLayers - Middle1: %d, Middle2: %d"), Middle1Spawned, Middle2Spawned);
-}
-
-void URoomGenerator::SpawnTopWallLayer()
-{
-	if (! RoomData || RoomData->WallStyleData.IsNull()) return;
-
-	// Get fallback height from WallData
-	float FallbackHeight = 100.0f;  // Default fallback
-	WallData = RoomData->WallStyleData.LoadSynchronous();
-	if (WallData) {	FallbackHeight = WallData->WallHeight;}
-
-	int32 TopSpawned = 0;
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator:: SpawnTopWallLayer - Processing %d wall segments"), PlacedWallMeshes.Num());
-
-	for (FPlacedWallInfo& Wall :  PlacedWallMeshes)
-	{
-		// Load top mesh (required)
-		UStaticMesh* TopMesh = Wall.WallModule. TopMesh.LoadSynchronous();
-		if (!TopMesh)continue;
-	 
-		// DETERMINE WHICH LAYER TO STACK ON (Priority:  Middle2 > Middle1 > Base)
-		// Load middle meshes to determine stack point
-		UStaticMesh* Middle2Mesh = Wall.WallModule.MiddleMesh2.LoadSynchronous();
-		UStaticMesh* Middle1Mesh = Wall.WallModule. MiddleMesh1.LoadSynchronous();
-
-		UStaticMesh* SnapToMesh = nullptr;
-		FTransform StackBaseTransform;
-
-		// Priority 1: Stack on Middle2 (if it exists)
-		if (Middle2Mesh)
+		// MIDDLE 1 LAYER (walls without one are not recorded)
+		if (!Meshes->Middle1) continue;
+
+		FPlacedWallInfo& PlacedWall = PlacedWallMeshes.AddDefaulted_GetRef();
+		PlacedWall.Edge = Segment.Edge;
+		PlacedWall.StartCell = Segment.StartCell;
+		PlacedWall.SpanLength = Segment.SegmentLength;
+		PlacedWall.ModuleIndex = AddToWallModulePalette(*Segment.WallModule);
+		PlacedWall.BottomTransform = Segment.BaseTransform;
+		PlacedWall.Middle1Transform = WallData->GetStackSocketTransform(Segment.BaseMesh) * Segment.BaseTransform;
+		Middle1Spawned++;
+
+		// MIDDLE 2 LAYER
+		UStaticMesh* SnapToMesh = Meshes->Middle1;
+		const FTransform* StackBaseTransform = &PlacedWall.Middle1Transform;
+		if (Meshes->Middle2)
 		{
-			SnapToMesh = Middle2Mesh;
-			StackBaseTransform = Wall.Middle2Transform;
+			PlacedWall.Middle2Transform = WallData->GetStackSocketTransform(Meshes->Middle1) * PlacedWall.Middle1Transform;
+			SnapToMesh = Meshes->Middle2;
+			StackBaseTransform = &PlacedWall.Middle2Transform;
+			Middle2Spawned++;
 		}
-		// Priority 2: Stack on Middle1 (if Middle2 doesn't exist)
-		else if (Middle1Mesh)
-		{
-			SnapToMesh = Middle1Mesh;
-			StackBaseTransform = Wall.Middle1Transform;
-		}
-		// Priority 3: Stack directly on Base
-		else
+
+		// TOP LAYER (stacks on Middle2 if present, otherwise Middle1)
+		if (Meshes->Top)
 		{
-			SnapToMesh = Wall.WallModule.BaseMesh. LoadSynchronous();
-			StackBaseTransform = Wall. BottomTransform;
+			PlacedWall.TopTransform = WallData->GetStackSocketTransform(SnapToMesh) * *StackBaseTransform;
+			TopSpawned++;
 		}
-	 
-		// CALCULATE TOP TRANSFORM USING SOCKET HELPER
-		FTransform TopWorldTransform = URoomGenerationHelpers::CalculateSocketWorldTransform(
-		SnapToMesh, FName("TopBackCenter"), StackBaseTransform, FVector(0, 0, FallbackHeight));
-		// Store transform
-		Wall.TopTransform = TopWorldTransform;
-		TopSpawned++;
+
+		PublishWallPlacement(PlacedWall, *Segment.WallModule);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::SpawnTopWallLayer - Top meshes: %d"), TopSpawned);
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::StackWallLayers - Middle1: %d, Middle2: %d, Top: %d"),
+		Middle1Spawned, Middle2Spawned, TopSpawned);
 }
 #pragma endregion
 
@@ -666,6 +618,25 @@ void URoomGenerator::ClearPlacedCorners()
 }
 #pragma endregion
 
+#pragma region Placement Streaming
+void URoomGenerator::PublishPlacement(ERoomMeshCategory Category, const TSoftObjectPtr<UStaticMesh>& Mesh, const FTransform& Transform)
+{
+	if (!bStreamPlacements || Mesh.IsNull()) return;
+	PlacementQueue.Enqueue({ Category, Mesh, Transform });
+}
+
+void URoomGenerator::PublishWallPlacement(const FPlacedWallInfo& PlacedWall, const FWallModule& Module)
+{
+	if (!bStreamPlacements) return;
+
+	// Null layers are skipped by PublishPlacement
+	PublishPlacement(ERoomMeshCategory::Wall, Module.BaseMesh, PlacedWall.BottomTransform);
+	PublishPlacement(ERoomMeshCategory::Wall, Module.MiddleMesh1, PlacedWall.Middle1Transform);
+	PublishPlacement(ERoomMeshCategory::Wall, Module.MiddleMesh2, PlacedWall.Middle2Transform);
+	PublishPlacement(ERoomMeshCategory::Wall, Module.TopMesh, PlacedWall.TopTransform);
+}
+#pragma endregion
+
 #pragma region Doorway Generation
 FPlacedDoorwayInfo URoomGenerator::CalculateDoorwayTransforms(const FDoorwayLayoutInfo& Layout)
 {
@@ -725,28 +696,31 @@ FPlacedDoorwayInfo URoomGenerator::CalculateDoorwayTransforms(const FDoorwayLayo
 
 void URoomGenerator::MarkDoorwayCells()
 {
+    for (int32 EdgeSlot = 0; EdgeSlot < 4; ++EdgeSlot)
+    {
+        const FEdgeCellView EdgeCells = URoomGenerationHelpers::GetEdgeCellView(static_cast<EWallEdge>(EdgeSlot + 1), GridSize);
+        DoorwayEdgeBits[EdgeSlot].Init(false, EdgeCells.Num());
+    }
+
     for (const FPlacedDoorwayInfo& Doorway : PlacedDoorwayMeshes)
     {
-        TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(Doorway.Edge, GridSize);
+        if (Doorway.Edge == EWallEdge::None) continue;
+
+        const FEdgeCellView EdgeCells = URoomGenerationHelpers::GetEdgeCellView(Doorway.Edge, GridSize);
+        TBitArray<>& EdgeBits = DoorwayEdgeBits[static_cast<int32>(Doorway.Edge) - 1];
 
         for (int32 i = 0; i < Doorway.WidthInCells; ++i)
         {
             int32 CellIndex = Doorway.StartCell + i;
-            if (CellIndex >= 0 && CellIndex < EdgeCells.Num())
+            if (EdgeCells.IsValidIndex(CellIndex))
             {
                 FIntPoint Cell = EdgeCells[CellIndex];
+                EdgeBits[CellIndex] = true;
                 
                 // Mark in grid state (if cell is within interior grid)
                 // Note:  Boundary cells (virtual) are outside interior grid bounds
                 // So we only mark if cell is within (0, GridSize-1)
-                if (Cell.X >= 0 && Cell.X < GridSize. X && Cell.Y >= 0 && Cell.Y < GridSize.Y)
-                {
-                    int32 GridIndex = Cell.Y * GridSize.X + Cell.X;
-                    if (GridState. IsValidIndex(GridIndex))
-                    {
-                        GridState[GridIndex] = EGridCellType::ECT_Doorway;
-                    }
-                }
+                GridKernel.SetCell(Cell, EKernelCellType::ECT_Doorway);
                 
                 UE_LOG(LogTemp, VeryVerbose, TEXT("    Marked doorway cell:  (%d, %d)"), Cell.X, Cell.Y);
             }
@@ -756,41 +730,36 @@ void URoomGenerator::MarkDoorwayCells()
 
 bool URoomGenerator::IsCellPartOfDoorway(FIntPoint Cell) const
 {
-	for (const FPlacedDoorwayInfo& Doorway :  PlacedDoorwayMeshes)
-	{
-		TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(Doorway. Edge, GridSize);
+	// Boundary cells belong to exactly one edge
+	EWallEdge Edge = EWallEdge::None;
+	if (Cell.X == GridSize.X) Edge = EWallEdge::North;
+	else if (Cell.X == -1) Edge = EWallEdge::South;
+	else if (Cell.Y == GridSize.Y) Edge = EWallEdge::East;
+	else if (Cell.Y == -1) Edge = EWallEdge::West;
+	if (Edge == EWallEdge::None) return false;
+
+	return IsEdgeCellDoorway(Edge, URoomGenerationHelpers::GetEdgeCellView(Edge, GridSize).IndexOf(Cell));
+}
 
-		for (int32 i = 0; i < Doorway.WidthInCells; ++i)
-		{
-			int32 CellIndex = Doorway.StartCell + i;
-			if (CellIndex >= 0 && CellIndex < EdgeCells.Num())
-			{
-				FIntPoint DoorwayCell = EdgeCells[CellIndex];
-                
-				// ✅ ADD LOGGING: 
-				if (Cell == DoorwayCell)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("    Cell (%d,%d) IS part of doorway on edge %s at index %d"),
-						Cell. X, Cell.Y, *UEnum::GetValueAsString(Doorway.Edge), CellIndex);
-					return true;
-				}
-			}
-		}
-	}
+bool URoomGenerator::IsEdgeCellDoorway(EWallEdge Edge, int32 CellIndex) const
+{
+	if (Edge == EWallEdge::None) return false;
 
-	return false;
+	const TBitArray<>& EdgeBits = DoorwayEdgeBits[static_cast<int32>(Edge) - 1];
+	return EdgeBits.IsValidIndex(CellIndex) && EdgeBits[CellIndex];
 }
 
 void URoomGenerator::ClearPlacedDoorways()
 {
     PlacedDoorwayMeshes.Empty();
 	CachedDoorwayLayouts. Empty(); 
+	for (TBitArray<>& EdgeBits : DoorwayEdgeBits) EdgeBits.Empty();
 }
 #pragma endregion
 
 #pragma region Ceiling Generation
 
-int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupied)
+int32 URoomGenerator::ExecuteForcedCeilingPlacements()
 {
     if (!bIsInitialized || ! RoomData)
     {
@@ -811,53 +780,13 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
     int32 SuccessfulPlacements = 0;
 
     // Load ceiling data for height/rotation
-    CeilingData = RoomData->CeilingStyleData.LoadSynchronous();
+    CeilingData = RoomData->CeilingStyleData.Get();
     if (!CeilingData)
     {
-        UE_LOG(LogTemp, Error, TEXT("ExecuteForcedCeilingPlacements - Failed to load CeilingStyleData"));
+        UE_LOG(LogTemp, Error, TEXT("ExecuteForcedCeilingPlacements - CeilingStyleData is not loaded"));
         return 0;
     }
 
-    // Lambda: Check if area is available
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 CheckX = StartX + dx;
-                int32 CheckY = StartY + dy;
-                
-                if (CheckX < 0 || CheckX >= GridSize.X || CheckY < 0 || CheckY >= GridSize.Y)
-                    return false;
-
-                int32 Index = CheckY * GridSize.X + CheckX;
-                if (CeilingOccupied. IsValidIndex(Index) && CeilingOccupied[Index])
-                    return false;
-            }
-        }
-        return true;
-    };
-
-    // Lambda: Mark cells as occupied
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                int32 Index = Y * GridSize.X + X;
-
-                if (CeilingOccupied.IsValidIndex(Index))
-                {
-                    CeilingOccupied[Index] = true;
-                }
-            }
-        }
-    };
-
     // Process each forced placement
     for (int32 i = 0; i < RoomData->ForcedCeilingPlacements. Num(); ++i)
     {
@@ -883,7 +812,7 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
         FIntPoint BestFootprint;
 
         // Determine rotations to try
-        TArray<int32> RotationsToTry;
+        TArray<int32, TInlineAllocator<4>> RotationsToTry;
         if (ForcedTile.AllowedRotations.Num() > 0)
         {
             RotationsToTry = ForcedTile.AllowedRotations;  // Use forced placement overrides
@@ -897,25 +826,16 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
             RotationsToTry. Add(0);  // Default to no rotation
         }
 
-        // Try each allowed rotation
+        // Try each allowed rotation (kernel check includes grid bounds)
         for (int32 Rotation : RotationsToTry)
         {
             FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
 
-            // Check bounds
-            int32 EndX = ForcedTile.GridCoordinate.X + RotatedFootprint.X;
-            int32 EndY = ForcedTile.GridCoordinate.Y + RotatedFootprint.Y;
-
-            if (EndX <= GridSize.X && EndY <= GridSize.Y &&
-                ForcedTile.GridCoordinate.X >= 0 && ForcedTile.GridCoordinate.Y >= 0)
+            if (CeilingKernel.IsAreaAvailable(ForcedTile.GridCoordinate, RotatedFootprint, EKernelCellType::ECT_Empty))
             {
-                // Check availability
-                if (IsAreaAvailable(ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y, RotatedFootprint))
-                {
-                    BestRotation = Rotation;
-                    BestFootprint = RotatedFootprint;
-                    break; // Use first valid rotation
-                }
+                BestRotation = Rotation;
+                BestFootprint = RotatedFootprint;
+                break; // Use first valid rotation
             }
         }
 
@@ -927,33 +847,8 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
             continue;
         }
 
-        // Calculate tile position (centered on footprint)
-        FVector TilePosition = FVector(
-            (ForcedTile.GridCoordinate.X + BestFootprint.X / 2.0f) * CellSize,
-            (ForcedTile.GridCoordinate.Y + BestFootprint.Y / 2.0f) * CellSize,
-            CeilingData->CeilingHeight
-        );
-
-        // Create rotation (base ceiling rotation + tile rotation)
-        FRotator FinalRotation = CeilingData->CeilingRotation;
-        FinalRotation.Yaw += BestRotation;
-
-        // Normalize quaternion to avoid floating point errors
-        FQuat NormalizedRotation = FinalRotation.Quaternion();
-        NormalizedRotation.Normalize();
-
-        // Create transform
-        FTransform TileTransform(NormalizedRotation, TilePosition, FVector(1.0f));
-
-        // Create placed ceiling info
-        FPlacedCeilingInfo PlacedTile;
-        PlacedTile.GridCoordinate = ForcedTile.GridCoordinate;
-        PlacedTile.TileSize = BestFootprint;
-        PlacedTile.MeshInfo = TileInfo;  // ✅ Store full MeshPlacementInfo
-         PlacedTile.LocalTransform = TileTransform;
-
-        PlacedCeilingTiles.Add(PlacedTile);
-        MarkCellsOccupied(ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y, BestFootprint);
+        CeilingKernel.MarkArea(ForcedTile.GridCoordinate, BestFootprint, EKernelCellType::ECT_FloorMesh);
+        RecordCeilingPlacement(ForcedTile.GridCoordinate, BestFootprint, TileInfo, BestRotation);
 
         UE_LOG(LogTemp, Log, TEXT("    ✓ Placed forced tile at (%d,%d) size (%dx%d) rotation (%d°)"),
             ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y,
@@ -967,95 +862,64 @@ int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupi
 
     return SuccessfulPlacements;
 }
+
+void URoomGenerator::RecordCeilingPlacement(FIntPoint GridCoordinate, FIntPoint TileSize, const FMeshPlacementInfo& TileInfo, int32 Rotation)
+{
+    // Transform is derived on demand (GetCeilingTileTransform)
+    FPlacedCeilingInfo& PlacedTile = PlacedCeilingTiles.AddDefaulted_GetRef();
+    PlacedTile.SetPlacement(GridCoordinate, TileSize, Rotation);
+    PlacedTile.MeshIndex = AddToMeshPalette(TileInfo.MeshAsset);
+    PublishPlacement(ERoomMeshCategory::Ceiling, TileInfo.MeshAsset, GetCeilingTileTransform(PlacedTile));
+}
 #pragma endregion
 
 #pragma region Internal Floor Generation
 void URoomGenerator::FillWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, 
+	const FKernelTilePool& CompiledPool,
 	FIntPoint TargetSize,
+	FRandomStream& Stream,
 	int32& OutLargeTiles,
 	int32& OutMediumTiles,
 	int32& OutSmallTiles,
 	int32& OutFillerTiles)
 {
-	// Filter tiles that match target size
-	TArray<FMeshPlacementInfo> MatchingTiles;
-
-	for (const FMeshPlacementInfo& MeshInfo : TilePool)
-	{
-		FIntPoint Footprint = CalculateFootprint(MeshInfo);
-
-		// Check if footprint matches target size (or rotated version)
-		if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) ||
-			(Footprint.X == TargetSize.Y && Footprint. Y == TargetSize.X))
-		{
-			MatchingTiles.Add(MeshInfo);
-		}
-	}
+	TKernelScratchArray<FKernelTilePlacement> Placements;
+	int32 PlacedCount = GridKernel.FillWithTileSize(CompiledPool, TargetSize, ToKernelCell(FloorTargetCellType), EKernelCellType::ECT_FloorMesh, Stream, Placements);
+	if (PlacedCount == 0) return; // No tiles of this size, or no space left
 
-	if (MatchingTiles.Num() == 0) return; // No tiles of this size
+	UE_LOG(LogTemp, Verbose, TEXT("URoomGenerator::FillWithTileSize - Placed %d %dx%d tiles"), 
+		PlacedCount, TargetSize.X, TargetSize.Y);
 
-	UE_LOG(LogTemp, Verbose, TEXT("URoomGenerator::FillWithTileSize - Filling with %dx%d tiles (%d options)"), 
-		TargetSize.X, TargetSize.Y, MatchingTiles.Num());
-
-	// Try to place tiles of this size across the grid
-	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	for (const FKernelTilePlacement& Placement : Placements)
 	{
-		for (int32 X = 0; X < GridSize.X; ++X)
-		{
-			FIntPoint StartCoord(X, Y);
-
-			// Check if area is available for target size
-			if (IsAreaAvailable(StartCoord, TargetSize))
-			{
-				// Select weighted random mesh
-				FMeshPlacementInfo SelectedMesh = SelectWeightedMesh(MatchingTiles);
-				FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
-
-				// Find rotation that matches target size
-				int32 BestRotation = 0;
-				
-				if (SelectedMesh.AllowedRotations.Num() > 0)
-				{
-					// Build list of rotations that would fit the target size
-					TArray<int32> ValidRotations;
-
-					for (int32 Rotation :  SelectedMesh.AllowedRotations)
-					{
-						FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-						
-						if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-						{
-							ValidRotations.Add(Rotation);
-						}
-					}
+		RecordFloorPlacement(Placement.Position, Placement.Footprint, TilePool[Placement.MeshId], Placement.Rotation);
+	}
+	AddTileStatistics(TargetSize, PlacedCount, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
+}
 
-					// Select random rotation from valid options
-					if (ValidRotations.Num() > 0)
-					{
-						int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-						BestRotation = ValidRotations[RandomIndex];
-					}
-				}
+void URoomGenerator::RecordFloorPlacement(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
+{
+	// Transform is derived on demand (GetFloorTileTransform)
+	FPlacedMeshInfo& PlacedMesh = PlacedFloorMeshes.AddDefaulted_GetRef();
+	PlacedMesh.SetPlacement(StartCoord, Size, Rotation);
+	PlacedMesh.MeshIndex = AddToMeshPalette(MeshInfo.MeshAsset);
+	PublishPlacement(ERoomMeshCategory::Floor, MeshInfo.MeshAsset, GetFloorTileTransform(PlacedMesh));
+}
 
-				// Try to place mesh with selected rotation
-				if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
-				{
-					// Update statistics
-					int32 TileArea = TargetSize.X * TargetSize.Y;
-					if (TileArea >= 16) OutLargeTiles++;
-					else if (TileArea >= 4) OutMediumTiles++;
-					else if (TileArea >= 2) OutSmallTiles++;
-					else OutFillerTiles++;
-				}
-			}
-		}
-	}
+void URoomGenerator::AddTileStatistics(FIntPoint TileSize, int32 Count, int32& OutLargeTiles, int32& OutMediumTiles,
+	int32& OutSmallTiles, int32& OutFillerTiles)
+{
+	int32 TileArea = TileSize.X * TileSize.Y;
+	if (TileArea >= 16) OutLargeTiles += Count;
+	else if (TileArea >= 4) OutMediumTiles += Count;
+	else if (TileArea >= 2) OutSmallTiles += Count;
+	else OutFillerTiles += Count;
 }
 
-FMeshPlacementInfo URoomGenerator::SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool)
+FMeshPlacementInfo URoomGenerator::SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool, FRandomStream& Stream)
 {
 	// Delegate to helper function
-	const FMeshPlacementInfo* Selected = URoomGenerationHelpers::SelectWeightedMeshPlacement(Pool);
+	const FMeshPlacementInfo* Selected = URoomGenerationHelpers::SelectWeightedMeshPlacement(Pool, Stream);
 	
 	// Return by value (copy), or empty if selection failed
 	if (Selected) return *Selected;
@@ -1065,338 +929,52 @@ FMeshPlacementInfo URoomGenerator::SelectWeightedMesh(const TArray<FMeshPlacemen
 
 bool URoomGenerator::TryPlaceMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
 {
-	if (! URoomGenerationHelpers::TryPlaceMeshInGrid(GridState, GridSize, StartCoord, Size, 
-	   FloorTargetCellType,EGridCellType::ECT_FloorMesh))
-	   	return false;
-	
-	// Create placed mesh info
-	FPlacedMeshInfo PlacedMesh;
-	PlacedMesh.GridPosition = StartCoord;
-	PlacedMesh.GridFootprint = Size;
-	PlacedMesh. Rotation = Rotation;
-	PlacedMesh.MeshInfo = MeshInfo;
-
-	// Calculate transform using helper
-	PlacedMesh.LocalTransform = URoomGenerationHelpers::CalculateMeshTransform(StartCoord,Size,
-	CellSize, Rotation,0.0f);  // Z offset (floor is at 0)
-
-	// Store placed mesh (internal state management)
-	PlacedFloorMeshes.Add(PlacedMesh);
+	if (!GridKernel.TryPlaceArea(StartCoord, Size, ToKernelCell(FloorTargetCellType), EKernelCellType::ECT_FloorMesh)) return false;
 
+	RecordFloorPlacement(StartCoord, Size, MeshInfo, Rotation);
 	return true;
 }
 
 FIntPoint URoomGenerator::CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const
 {
-	// If footprint is explicitly defined, use it
-	if (MeshInfo.GridFootprint.X > 0 && MeshInfo. GridFootprint.Y > 0) return MeshInfo.GridFootprint;
-
-	// Otherwise, calculate from mesh bounds
-	if (! MeshInfo.MeshAsset. IsNull())
-	{
-		// For now, return default 1x1 if bounds not available
-		// TODO: Load mesh and calculate actual bounds
-		return FIntPoint(1, 1);
-	}
-
-	// Fallback
-	return FIntPoint(1, 1);
+	// Delegate to helper function (same rule the compiled style pools use)
+	return URoomGenerationHelpers::CalculateMeshFootprint(MeshInfo);
 }
 
-void URoomGenerator::FillCeilingWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, TArray<bool>& CeilingOccupied,
-	FIntPoint TargetSize, const FRotator& CeilingRotation, float CeilingHeight, int32& OutTilesPlaced)
+void URoomGenerator::FillCeilingWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, const FKernelTilePool& CompiledPool,
+	FIntPoint TargetSize, FRandomStream& Stream, int32& OutTilesPlaced)
 {
-	// Filter tiles that match target size
-    TArray<FMeshPlacementInfo> MatchingTiles;
+    TKernelScratchArray<FKernelTilePlacement> Placements;
+    int32 PlacedCount = CeilingKernel.FillWithTileSize(CompiledPool, TargetSize, EKernelCellType::ECT_Empty, EKernelCellType::ECT_FloorMesh, Stream, Placements);
+    if (PlacedCount == 0) return; // No tiles of this size, or no space left
 
-    for (const FMeshPlacementInfo& TileInfo :  TilePool)
-    {
-        FIntPoint Footprint = CalculateFootprint(TileInfo);
+    UE_LOG(LogTemp, Verbose, TEXT("  Filled ceiling with %d %dx%d tiles"), PlacedCount, TargetSize.X, TargetSize. Y);
 
-        // Check if footprint matches target size (or rotated version)
-        if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize. Y) ||
-            (Footprint.X == TargetSize.Y && Footprint.Y == TargetSize.X))
-        {
-            MatchingTiles.Add(TileInfo);
-        }
-    }
-
-    if (MatchingTiles. Num() == 0) return; // No tiles of this size
-
-    UE_LOG(LogTemp, Verbose, TEXT("  Filling ceiling with %dx%d tiles (%d options)"),
-        TargetSize.X, TargetSize. Y, MatchingTiles. Num());
-
-    // Lambda:  Check if cell is occupied
-    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
-    {
-        if (X < 0 || X >= GridSize.X || Y < 0 || Y >= GridSize.Y) return true;
-        return CeilingOccupied[Y * GridSize.X + X];
-    };
-
-    // Lambda: Check if area is available
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
+    for (const FKernelTilePlacement& Placement : Placements)
     {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                if (IsCellOccupied(StartX + dx, StartY + dy))
-                    return false;
-            }
-        }
-        return true;
-    };
-
-    // Lambda: Mark cells as occupied
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                if (X >= 0 && X < GridSize.X && Y >= 0 && Y < GridSize.Y)
-                {
-                    CeilingOccupied[Y * GridSize.X + X] = true;
-                }
-            }
-        }
-    };
-
-    // Try to place tiles of this size across the grid
-    for (int32 Y = 0; Y < GridSize.Y; ++Y)
-    {
-        for (int32 X = 0; X < GridSize.X; ++X)
-        {
-            // Check if area is available for target size
-            if (IsAreaAvailable(X, Y, TargetSize))
-            {
-                // Select weighted random mesh
-                FMeshPlacementInfo SelectedTile = SelectWeightedMesh(MatchingTiles);
-                FIntPoint OriginalFootprint = CalculateFootprint(SelectedTile);
-
-                // Find rotation that matches target size
-                int32 BestRotation = 0;
-
-                if (SelectedTile.AllowedRotations.Num() > 0)
-                {
-                    // Build list of rotations that would fit the target size
-                    TArray<int32> ValidRotations;
-
-                    for (int32 Rotation : SelectedTile.AllowedRotations)
-                    {
-                        FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-
-                        if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-                        {
-                            ValidRotations.Add(Rotation);
-                        }
-                    }
-
-                    // Select random rotation from valid options
-                    if (ValidRotations.Num() > 0)
-                    {
-                        int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-                        BestRotation = ValidRotations[RandomIndex];
-                    }
-                }
-            	           	
-                // Calculate tile position (centered on footprint)
-                FVector TilePosition = FVector(
-                    (X + TargetSize.X / 2.0f) * CellSize,
-                    (Y + TargetSize.Y / 2.0f) * CellSize,
-                    CeilingHeight
-                );
-
-                // Create rotation (base ceiling rotation + tile rotation)
-                FRotator FinalRotation = CeilingRotation;
-                FinalRotation. Yaw += BestRotation;
-            	
-                // Create transform
-                FTransform TileTransform(FinalRotation, TilePosition, FVector(1.0f));
-
-                // Create placed ceiling info
-                FPlacedCeilingInfo PlacedTile;
-                PlacedTile. GridCoordinate = FIntPoint(X, Y);
-                PlacedTile.TileSize = TargetSize;
-                PlacedTile.MeshInfo = SelectedTile;  // ✅ Store full MeshPlacementInfo
-                 PlacedTile.LocalTransform = TileTransform;
-
-                PlacedCeilingTiles.Add(PlacedTile);
-                MarkCellsOccupied(X, Y, TargetSize);
-                OutTilesPlaced++;
-            }
-        }
+        RecordCeilingPlacement(Placement.Position, Placement.Footprint, TilePool[Placement.MeshId], Placement.Rotation);
     }
+    OutTilesPlaced += PlacedCount;
 }
 
-int32 URoomGenerator::FillRemainingCeilingGaps(const TArray<FMeshPlacementInfo>& TilePool,
-	TArray<bool>& CeilingOccupied, const FRotator& CeilingRotation, float CeilingHeight, int32& OutLargeTiles,
-	int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
+int32 URoomGenerator::FillRemainingCeilingGaps(const TArray<FMeshPlacementInfo>& TilePool, const FKernelTilePool& CompiledPool,
+	FRandomStream& Stream, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
 {
-	 if (TilePool.Num() == 0)
+    if (TilePool.Num() == 0)
     {
         UE_LOG(LogTemp, Warning, TEXT("  FillRemainingCeilingGaps - No tiles in pool!"));
         return 0;
     }
 
-    int32 PlacedCount = 0;
-
-    // Define sizes to try (largest to smallest for efficiency)
-    TArray<FIntPoint> SizesToTry = {
-        FIntPoint(1, 4), // 100x400
-        FIntPoint(4, 1), // 400x100
-        FIntPoint(1, 2), // 100x200
-        FIntPoint(2, 1), // 200x100
-        FIntPoint(1, 1)  // 100x100
-    };
-
     UE_LOG(LogTemp, Verbose, TEXT("  FillRemainingCeilingGaps - Starting gap fill"));
 
-    // Lambda: Check if cell is occupied
-    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
-    {
-        if (X < 0 || X >= GridSize.X || Y < 0 || Y >= GridSize.Y) return true;
-        return CeilingOccupied[Y * GridSize.X + X];
-    };
-
-    // Lambda:  Check if area is available
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                if (IsCellOccupied(StartX + dx, StartY + dy))
-                    return false;
-            }
-        }
-        return true;
-    };
+    TKernelScratchArray<FKernelTilePlacement> Placements;
+    int32 PlacedCount = CeilingKernel.FillRemainingGaps(CompiledPool, EKernelCellType::ECT_Empty, EKernelCellType::ECT_FloorMesh, Stream, Placements);
 
-    // Lambda: Mark cells as occupied
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
+    for (const FKernelTilePlacement& Placement : Placements)
     {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                if (X >= 0 && X < GridSize. X && Y >= 0 && Y < GridSize.Y)
-                {
-                    CeilingOccupied[Y * GridSize.X + X] = true;
-                }
-            }
-        }
-    };
-
-    // Try each size in order
-    for (const FIntPoint& TargetSize : SizesToTry)
-    {
-        // Filter tiles that match this size
-        TArray<FMeshPlacementInfo> MatchingTiles;
-
-        for (const FMeshPlacementInfo& TileInfo : TilePool)
-        {
-            FIntPoint Footprint = CalculateFootprint(TileInfo);
-
-            // Check if footprint matches target size (or rotated version)
-            if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) ||
-                (Footprint.X == TargetSize.Y && Footprint.Y == TargetSize.X))
-            {
-                MatchingTiles.Add(TileInfo);
-            }
-        }
-
-        if (MatchingTiles.Num() == 0) continue; // No tiles of this size, try next
-
-        int32 SizePlacedCount = 0;
-
-        // Try to place tiles of this size in all empty spaces
-        for (int32 Y = 0; Y < GridSize.Y; ++Y)
-        {
-            for (int32 X = 0; X < GridSize.X; ++X)
-            {
-                // Check if area is available
-                if (IsAreaAvailable(X, Y, TargetSize))
-                {
-                    // Select weighted random mesh
-                    FMeshPlacementInfo SelectedTile = SelectWeightedMesh(MatchingTiles);
-                    FIntPoint OriginalFootprint = CalculateFootprint(SelectedTile);
-
-                    // Find rotation that matches target size
-                    int32 BestRotation = 0;
-
-                    if (SelectedTile.AllowedRotations. Num() > 0)
-                    {
-                        // Build list of rotations that would fit the target size
-                        TArray<int32> ValidRotations;
-
-                        for (int32 Rotation : SelectedTile.AllowedRotations)
-                        {
-                            FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-
-                            if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-                            {
-                                ValidRotations.Add(Rotation);
-                            }
-                        }
-
-                        // Select random rotation from valid options
-                        if (ValidRotations.Num() > 0)
-                        {
-                            int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-                            BestRotation = ValidRotations[RandomIndex];
-                        }
-                    }
-
-                    // Calculate tile position
-                    FVector TilePosition = FVector(
-                        (X + TargetSize.X / 2.0f) * CellSize,
-                        (Y + TargetSize.Y / 2.0f) * CellSize,
-                        CeilingHeight
-                    );
-
-                    // Create rotation
-                    FRotator FinalRotation = CeilingRotation;
-                    FinalRotation. Yaw += BestRotation;
-
-                    // Normalize quaternion
-                    FQuat NormalizedRotation = FinalRotation. Quaternion();
-                    NormalizedRotation.Normalize();
-
-                    // Create transform
-                    FTransform TileTransform(NormalizedRotation, TilePosition, FVector(1.0f));
-
-                    // Create placed ceiling info
-                    FPlacedCeilingInfo PlacedTile;
-                    PlacedTile.GridCoordinate = FIntPoint(X, Y);
-                    PlacedTile.TileSize = TargetSize;
-                    PlacedTile.MeshInfo = SelectedTile;  // ✅ Store full MeshPlacementInfo
-                     PlacedTile.LocalTransform = TileTransform;
-
-                    PlacedCeilingTiles. Add(PlacedTile);
-                    MarkCellsOccupied(X, Y, TargetSize);
-
-                    SizePlacedCount++;
-                    PlacedCount++;
-
-                    // Update statistics
-                    int32 TileArea = TargetSize.X * TargetSize.Y;
-                    if (TileArea >= 16) OutLargeTiles++;
-                    else if (TileArea >= 4) OutMediumTiles++;
-                    else if (TileArea >= 2) OutSmallTiles++;
-                    else OutFillerTiles++;
-                }
-            }
-        }
-
-        if (SizePlacedCount > 0)
-        {
-            UE_LOG(LogTemp, Verbose, TEXT("    Filled %d gaps with %dx%d tiles"), SizePlacedCount, TargetSize.X, TargetSize.Y);
-        }
+        RecordCeilingPlacement(Placement.Position, Placement.Footprint, TilePool[Placement.MeshId], Placement.Rotation);
+        AddTileStatistics(Placement.Footprint, 1, OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
     }
 
     UE_LOG(LogTemp, Verbose, TEXT("  FillRemainingCeilingGaps - Placed %d gap-fill tiles"), PlacedCount);
@@ -1437,13 +1015,67 @@ FIntPoint URoomGenerator::GetRotatedFootprint(FIntPoint OriginalFootprint, int32
 }
 #pragma endregion
 
+#pragma region Placement Palettes
+const TSoftObjectPtr<UStaticMesh>* URoomGenerator::FindPlacedMesh(const FPlacedMeshInfo& Placed) const
+{
+	return PlacedMeshPalette.IsValidIndex(Placed.MeshIndex) ? &PlacedMeshPalette[Placed.MeshIndex] : nullptr;
+}
+
+const FWallModule* URoomGenerator::FindPlacedWallModule(const FPlacedWallInfo& Placed) const
+{
+	return PlacedWallModulePalette.IsValidIndex(Placed.ModuleIndex) ? &PlacedWallModulePalette[Placed.ModuleIndex] : nullptr;
+}
+
+FTransform URoomGenerator::GetFloorTileTransform(const FPlacedMeshInfo& Placed) const
+{
+	return MakeFloorTileTransform(Placed, CellSize);
+}
+
+FTransform URoomGenerator::GetCeilingTileTransform(const FPlacedCeilingInfo& Placed) const
+{
+	const UCeilingData* Style = CeilingData ? CeilingData : GetDefault<UCeilingData>();
+	return MakeCeilingTileTransform(Placed, CellSize, Style->CeilingRotation, Style->CeilingHeight);
+}
+
+FTransform URoomGenerator::MakeFloorTileTransform(const FPlacedMeshInfo& Placed, float CellSize)
+{
+	// Floor is at Z = 0
+	return URoomGenerationHelpers::CalculateMeshTransform(Placed.GetGridPosition(), Placed.GetFootprint(), CellSize,
+		Placed.GetRotation(), 0.0f);
+}
+
+FTransform URoomGenerator::MakeCeilingTileTransform(const FPlacedCeilingInfo& Placed, float CellSize,
+	const FRotator& CeilingRotation, float CeilingHeight)
+{
+	return URoomGenerationHelpers::CalculateCeilingTransform(Placed.GetGridPosition(), Placed.GetFootprint(), CellSize,
+		Placed.GetRotation(), CeilingRotation, CeilingHeight);
+}
+
+int32 URoomGenerator::AddToMeshPalette(const TSoftObjectPtr<UStaticMesh>& Mesh)
+{
+	FScopeLock PaletteLock(&MeshPaletteLock);
+	if (const int32* Existing = MeshPaletteLookup.Find(Mesh)) return *Existing;
+
+	const int32 MeshIndex = PlacedMeshPalette.Add(Mesh);
+	MeshPaletteLookup.Add(Mesh, MeshIndex);
+	return MeshIndex;
+}
+
+int32 URoomGenerator::AddToWallModulePalette(const FWallModule& Module)
+{
+	if (const int32* Existing = WallModulePaletteLookup.Find(&Module)) return *Existing;
+
+	const int32 ModuleIndex = PlacedWallModulePalette.Add(Module);
+	WallModulePaletteLookup.Add(&Module, ModuleIndex);
+	return ModuleIndex;
+}
+#pragma endregion
+
 #pragma region Room Statistics
 
 int32 URoomGenerator::GetCellCountByType(EGridCellType CellType) const
 {
-	int32 Count = 0;
-	for (const EGridCellType& Cell : GridState)
-	{ if (Cell == CellType) ++Count; } return Count;
+	return GridKernel.CountCells(ToKernelCell(CellType));
 }
 
 float URoomGenerator::GetOccupancyPercentage() const
@@ -1456,6 +1088,88 @@ float URoomGenerator::GetOccupancyPercentage() const
 }
 #pragma endregion
 
+#pragma region Collision Proxies
+int32 URoomGenerator::BuildCollisionBoxes(float FloorThickness, float WallThickness, TArray<FBox>& OutBoxes) const
+{
+	const int32 StartCount = OutBoxes.Num();
+
+	// 1. Floor: greedy rectangles over placed floor cells
+	TArray<FIntRect> FloorRects;
+	GridKernel.MergeCellRects(EKernelCellType::ECT_FloorMesh, FloorRects);
+	for (const FIntRect& Rect : FloorRects)
+	{
+		OutBoxes.Add(FBox(FVector(Rect.Min.X * CellSize, Rect.Min.Y * CellSize, -FloorThickness),
+			FVector(Rect.Max.X * CellSize, Rect.Max.Y * CellSize, 0.0f)));
+	}
+
+	// 2. Walls: segments sorted by wall line (edge + position across the wall), then along the wall
+	const float WallHeight = WallData ? WallData->WallHeight : GetDefault<UWallData>()->WallHeight;
+	auto IsAlongY = [](EWallEdge Edge) { return Edge == EWallEdge::North || Edge == EWallEdge::South; };
+	auto GetAcross = [&IsAlongY](const FGeneratorWallSegment& Segment)
+	{
+		const FVector Location = Segment.BaseTransform.GetLocation();
+		return FMath::RoundToInt(IsAlongY(Segment.Edge) ? Location.X : Location.Y);
+	};
+
+	TArray<const FGeneratorWallSegment*> Segments;
+	Segments.Reserve(PlacedBaseWallSegments.Num());
+	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
+	{
+		if (Segment.Edge != EWallEdge::None && Segment.SegmentLength > 0) Segments.Add(&Segment);
+	}
+	Segments.Sort([&GetAcross](const FGeneratorWallSegment& A, const FGeneratorWallSegment& B)
+	{
+		if (A.Edge != B.Edge) return A.Edge < B.Edge;
+		const int32 AcrossA = GetAcross(A);
+		const int32 AcrossB = GetAcross(B);
+		return AcrossA != AcrossB ? AcrossA < AcrossB : A.StartCell < B.StartCell;
+	});
+
+	for (int32 RunStart = 0; RunStart < Segments.Num();)
+	{
+		const FGeneratorWallSegment& First = *Segments[RunStart];
+		const int32 Across = GetAcross(First);
+		int32 RunEndCell = First.StartCell + First.SegmentLength;
+
+		// Extend while the next segment continues the same line without a gap (doorways break runs)
+		int32 Next = RunStart + 1;
+		while (Next < Segments.Num() && Segments[Next]->Edge == First.Edge && GetAcross(*Segments[Next]) == Across
+			&& Segments[Next]->StartCell <= RunEndCell)
+		{
+			RunEndCell = FMath::Max(RunEndCell, Segments[Next]->StartCell + Segments[Next]->SegmentLength);
+			++Next;
+		}
+
+		const float AlongMin = First.StartCell * CellSize;
+		const float AlongMax = RunEndCell * CellSize;
+		const float AcrossMin = First.BaseTransform.GetLocation()[IsAlongY(First.Edge) ? 0 : 1] - WallThickness * 0.5f;
+		const float BaseZ = First.BaseTransform.GetLocation().Z;
+
+		if (IsAlongY(First.Edge))
+		{
+			OutBoxes.Add(FBox(FVector(AcrossMin, AlongMin, BaseZ), FVector(AcrossMin + WallThickness, AlongMax, BaseZ + WallHeight)));
+		}
+		else
+		{
+			OutBoxes.Add(FBox(FVector(AlongMin, AcrossMin, BaseZ), FVector(AlongMax, AcrossMin + WallThickness, BaseZ + WallHeight)));
+		}
+		RunStart = Next;
+	}
+
+	// 3. Ceiling: greedy rectangles over placed ceiling cells, FloorThickness deep above the ceiling plane
+	const float CeilingHeight = (CeilingData ? CeilingData : GetDefault<UCeilingData>())->CeilingHeight;
+	TArray<FIntRect> CeilingRects;
+	CeilingKernel.MergeCellRects(EKernelCellType::ECT_FloorMesh, CeilingRects);
+	for (const FIntRect& Rect : CeilingRects)
+	{
+		OutBoxes.Add(FBox(FVector(Rect.Min.X * CellSize, Rect.Min.Y * CellSize, CeilingHeight),
+			FVector(Rect.Max.X * CellSize, Rect.Max.Y * CellSize, CeilingHeight + FloorThickness)));
+	}
+
+	return OutBoxes.Num() - StartCount;
+}
+#pragma endregion
+
 #pragma region Internal Helpers
 
 int32 URoomGenerator::GridCoordToIndex(FIntPoint GridCoord) const
@@ -1472,103 +1186,47 @@ FIntPoint URoomGenerator:: IndexToGridCoord(int32 Index) const
 	return FIntPoint(X, Y);
 }
 
-void URoomGenerator::FillWallEdge(EWallEdge Edge)
+void URoomGenerator::FillWallEdge(EWallEdge Edge, FRandomStream& Stream)
 {
     if (!  RoomData || RoomData->WallStyleData.IsNull()) return;
 
-    WallData = RoomData->WallStyleData.LoadSynchronous();
+    WallData = RoomData->WallStyleData.Get();
     if (!WallData || WallData->AvailableWallModules. Num() == 0) return;
 
-    TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(Edge, GridSize);
+    const FEdgeCellView EdgeCells = URoomGenerationHelpers::GetEdgeCellView(Edge, GridSize);
     if (EdgeCells.Num() == 0) return;
 
     FRotator WallRotation = URoomGenerationHelpers:: GetWallRotationForEdge(Edge);
     UE_LOG(LogTemp, Verbose, TEXT("  Filling edge %s with %d cells"),
         *UEnum::GetValueAsString(Edge), EdgeCells.Num());
 
-    // Greedy bin packing: Fill with largest modules first (BASE LAYER ONLY)
-    int32 CurrentCell = 0;
+    // Fewest-module packing (BASE LAYER ONLY)
+    // Doorway cells and cells taken by forced walls stay open
+    const TSharedRef<const FKernelWallModuleTable, ESPMode::ThreadSafe> ModuleTable = WallData->GetCompiledWallModuleTable();
 
-    while (CurrentCell < EdgeCells. Num())
+    TKernelScratchArray<FKernelWallSpan> Spans;
+    FRoomGenerationKernel::PackWallRun(EdgeCells.Num(), *ModuleTable, [&](int32 CellIndex)
     {
-        // ✅ FIXED:   Check if THIS SPECIFIC CELL is part of a doorway
-        FIntPoint CellToCheck = EdgeCells[CurrentCell];
-        
-        if (IsCellPartOfDoorway(CellToCheck))
-        {
-            UE_LOG(LogTemp, Warning, TEXT("    Skipping cell %d (%d,%d) - part of doorway"),
-                CurrentCell, CellToCheck.X, CellToCheck.Y);
-            CurrentCell++;
-            continue;
-        }
-        
-        // Skip cells occupied by forced walls
-        if (IsCellRangeOccupied(Edge, CurrentCell, 1))
-        {
-            UE_LOG(LogTemp, VeryVerbose, TEXT("    Skipping cell %d (occupied by forced wall)"), CurrentCell);
-            CurrentCell++;
-            continue;
-        }
-        
-        // Find largest module that fits remaining space
-        const FWallModule* BestModule = nullptr;
-        int32 SpaceLeft = EdgeCells.Num() - CurrentCell;
-
-        for (const FWallModule& Module : WallData->AvailableWallModules)
-        {
-            // ✅ FIXED:  Check if the ENTIRE module span overlaps with doorways
-            bool bModuleOverlapsDoorway = false;
-            
-            for (int32 i = 0; i < Module. Y_AxisFootprint; ++i)
-            {
-                int32 CheckIndex = CurrentCell + i;
-                if (CheckIndex < EdgeCells.Num())
-                {
-                    FIntPoint CheckCell = EdgeCells[CheckIndex];
-                    if (IsCellPartOfDoorway(CheckCell))
-                    {
-                        bModuleOverlapsDoorway = true;
-                        break;
-                    }
-                }
-            }
-            
-            if (bModuleOverlapsDoorway)
-            {
-                continue;  // Skip this module - it would overlap a doorway
-            }
-            
-            if (Module.Y_AxisFootprint <= SpaceLeft && 
-                !  IsCellRangeOccupied(Edge, CurrentCell, Module.Y_AxisFootprint))
-            {
-                if (!  BestModule || Module.Y_AxisFootprint > BestModule->Y_AxisFootprint)
-                {
-                    BestModule = &Module;
-                }
-            }
-        }
+        return IsEdgeCellDoorway(Edge, CellIndex) || IsCellRangeOccupied(Edge, CellIndex, 1);
+    }, Stream, Spans);
 
-        if (! BestModule)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("    No wall module fits remaining %d cells on edge %s at cell %d"), 
-                SpaceLeft, *UEnum::GetValueAsString(Edge), CurrentCell);
-            CurrentCell++;  // Skip this cell and try next
-            continue;
-        }
+    for (const FKernelWallSpan& Span : Spans)
+    {
+        const FWallModule& Module = WallData->AvailableWallModules[Span.ModuleId];
 
         // Load base mesh
-        UStaticMesh* BaseMesh = BestModule->BaseMesh.LoadSynchronous();
+        UStaticMesh* BaseMesh = Module.BaseMesh.Get();
         if (!BaseMesh)
         {
-            UE_LOG(LogTemp, Warning, TEXT("    Failed to load base mesh for wall module"));
+            UE_LOG(LogTemp, Warning, TEXT("    Base mesh for wall module is not loaded"));
             break;
         }
 
         // Calculate position for this wall segment
         FVector BasePosition = URoomGenerationHelpers:: CalculateWallPosition(
             Edge,
-            CurrentCell,
-            BestModule->Y_AxisFootprint,
+            Span.StartIndex,
+            Span.Length,
             GridSize,
             CellSize,
             WallData->NorthWallOffsetX,
@@ -1583,19 +1241,15 @@ void URoomGenerator::FillWallEdge(EWallEdge Edge)
         // Store segment info for Middle/Top spawning
         FGeneratorWallSegment Segment;
         Segment.Edge = Edge;
-        Segment. StartCell = CurrentCell;
-        Segment. SegmentLength = BestModule->Y_AxisFootprint;
+        Segment. StartCell = Span.StartIndex;
+        Segment. SegmentLength = Span.Length;
         Segment.BaseTransform = BaseTransform;
         Segment.BaseMesh = BaseMesh;
-        Segment.WallModule = BestModule;
-
-        PlacedBaseWallSegments.Add(Segment);
+        Segment.WallModule = &Module;
 
-        UE_LOG(LogTemp, VeryVerbose, TEXT("    Tracked %d-cell base wall at cell %d"),
-            BestModule->Y_AxisFootprint, CurrentCell);
+        AddBaseWallSegment(Segment);
 
-        // Advance to next segment
-        CurrentCell += BestModule->Y_AxisFootprint;
+        UE_LOG(LogTemp, VeryVerbose, TEXT("    Tracked %d-cell base wall at cell %d"), Span.Length, Span.StartIndex);
     }
 }
 #pragma endregion
@@ -0,0 +1,67 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generators/Rooms/RoomStageGraph.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+int32 FRoomStageGraph::AddStage(FName Name, ERoomStageAccess Reads, ERoomStageAccess Writes, bool bRequired,
+	TFunction<bool(URoomGenerator&)> Run)
+{
+	FRoomStageNode& Stage = Stages.AddDefaulted_GetRef();
+	Stage.Name = Name;
+	Stage.Reads = Reads;
+	Stage.Writes = Writes;
+	Stage.bRequired = bRequired;
+	Stage.Run = MoveTemp(Run);
+	return Stages.Num() - 1;
+}
+
+FRoomStageNode* FRoomStageGraph::FindStage(FName Name)
+{
+	return Stages.FindByPredicate([Name](const FRoomStageNode& Stage) { return Stage.Name == Name; });
+}
+
+void FRoomStageGraph::GetPrerequisites(int32 Stage, TArray<int32>& OutPrerequisites) const
+{
+	OutPrerequisites.Reset();
+	if (!Stages.IsValidIndex(Stage)) return;
+
+	const FRoomStageNode& Node = Stages[Stage];
+	const ERoomStageAccess Touches = Node.Reads | Node.Writes;
+	for (int32 Earlier = 0; Earlier < Stage; ++Earlier)
+	{
+		const FRoomStageNode& Other = Stages[Earlier];
+		if (EnumHasAnyFlags(Other.Writes, Touches) || EnumHasAnyFlags(Other.Reads, Node.Writes)) OutPrerequisites.Add(Earlier);
+	}
+}
+
+bool FRoomStageGraph::Execute(URoomGenerator& Generator) const
+{
+	std::atomic<bool> bRequiredFailed = false;
+
+	TArray<UE::Tasks::FTask> StageTasks;
+	StageTasks.Reserve(Stages.Num());
+
+	TArray<int32> PrerequisiteIndices;
+	TArray<UE::Tasks::FTask> Prerequisites;
+	for (int32 Index = 0; Index < Stages.Num(); ++Index)
+	{
+		GetPrerequisites(Index, PrerequisiteIndices);
+		Prerequisites.Reset();
+		for (const int32 Prerequisite : PrerequisiteIndices) { Prerequisites.Add(StageTasks[Prerequisite]); }
+
+		// Locals are captured by reference, every task is waited for below
+		const FRoomStageNode& Stage = Stages[Index];
+		StageTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Stage, &Generator, &bRequiredFailed]()
+		{
+			if (bRequiredFailed) return;
+			if (Stage.Run(Generator)) return;
+
+			UE_LOG(LogTemp, Warning, TEXT("FRoomStageGraph::Execute - Stage %s failed"), *Stage.Name.ToString());
+			if (Stage.bRequired) bRequiredFailed = true;
+		}, UE::Tasks::Prerequisites(Prerequisites)));
+	}
+
+	UE::Tasks::Wait(StageTasks);
+	return !bRequiredFailed;
+}
@@ -5,6 +5,20 @@
 
 #include "Utilities/Generation/RoomGenerationHelpers.h"
 
+#pragma region Stage Graph
+void UUniformRoomGenerator::BuildStageGraph(FRoomStageGraph& Graph) const
+{
+	Super::BuildStageGraph(Graph);
+
+	// Uniform corners sit on the fixed grid bounds, they read no cells and keep WallData local
+	if (FRoomStageNode* Corners = Graph.FindStage(TEXT("Corners")))
+	{
+		Corners->Reads = ERoomStageAccess::None;
+		Corners->Writes = ERoomStageAccess::CornerPlacements;
+	}
+}
+#pragma endregion
+
 #pragma region Room Grid Management
 void UUniformRoomGenerator::CreateGrid()
 {
@@ -14,8 +28,7 @@ void UUniformRoomGenerator::CreateGrid()
 	UE_LOG(LogTemp, Log, TEXT("UniformRoomGenerator: Creating uniform rectangular grid..."));
     
 	// Initialize grid state array (all floor cells for uniform room)
-	GridState.SetNum(GridSize.X * GridSize.Y);
-	for (EGridCellType& Cell : GridState) { Cell = EGridCellType::ECT_Empty; }
+	GridKernel.Reset(GridSize, EKernelCellType::ECT_Empty, ToKernelCell(FloorTargetCellType));
     
 	// Log statistics
 	int32 TotalCells = GetTotalCellCount();
@@ -26,16 +39,18 @@ void UUniformRoomGenerator::CreateGrid()
 #pragma region Floor Generation
 bool UUniformRoomGenerator::GenerateFloor()
 {
+	FMemMark ScratchMark(FMemStack::Get());
+
 	if (!bIsInitialized)
 	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateFloor - Generator not initialized!")); return false; }
 
 	if (! RoomData || !RoomData->FloorStyleData)
 	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator:: GenerateFloor - FloorData not assigned!")); return false; }
 
-	// Load FloorData and keep strong reference throughout function
-	UFloorData* FloorStyleData = RoomData->FloorStyleData.LoadSynchronous();
+	// Style assets are streamed before generation, stages never load
+	UFloorData* FloorStyleData = RoomData->FloorStyleData.Get();
 	if (!FloorStyleData)
-	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateFloor - Failed to load FloorStyleData!")); return false; }
+	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateFloor - FloorStyleData is not loaded!")); return false; }
 
 	// Validate FloorTilePool exists
 	if (FloorStyleData->FloorTilePool. Num() == 0)
@@ -43,6 +58,7 @@ bool UUniformRoomGenerator::GenerateFloor()
 	
 	// Clear previous placement data
 	ClearPlacedFloorMeshes();
+	FRandomStream& Stream = BeginRandomStage(ERoomRandomStage::Floor);
 	
 	int32 FloorLargeTilesPlaced = 0;
 	int32 FloorMediumTilesPlaced = 0;
@@ -53,12 +69,8 @@ bool UUniformRoomGenerator::GenerateFloor()
 
  
 	// PHASE 0:  FORCED EMPTY REGIONS (Mark cells as reserved)
- 	TArray<FIntPoint> ForcedEmptyCells = ExpandForcedEmptyRegions();
-	if (ForcedEmptyCells.Num() > 0)
-	{
-		MarkForcedEmptyCells(ForcedEmptyCells);
-		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCells. Num());
-	}
+ 	const int32 ForcedEmptyCount = MarkForcedEmptyRegions();
+	if (ForcedEmptyCount > 0) { UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCount); }
 	
 	// PHASE 1: FORCED PLACEMENTS (Designer overrides - highest priority)
  	int32 ForcedCount = ExecuteForcedPlacements();
@@ -67,23 +79,24 @@ bool UUniformRoomGenerator::GenerateFloor()
 	// PHASE 2: GREEDY FILL (Large → Medium → Small)
  	// Use the FloorData pointer we loaded at the top (safer than re-accessing)
 	const TArray<FMeshPlacementInfo>& FloorMeshes = FloorStyleData->FloorTilePool;
+	const TSharedRef<const FKernelTilePool, ESPMode::ThreadSafe> FloorPool = FloorStyleData->GetCompiledFloorTilePool();
 	UE_LOG(LogTemp, Log, TEXT("  Phase 2: Greedy fill with %d tile options"), FloorMeshes.Num());
 
 	// Large tiles (400x400, 200x400, 400x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(4, 4), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(2, 4), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(4, 2), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 
 	// Medium tiles (200x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(2, 2), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 
 	// Small tiles (100x200, 200x100, 100x100)
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(1, 2), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(2, 1), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	FillWithTileSize(FloorMeshes, *FloorPool, FIntPoint(1, 1), Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 	
 	// PHASE 3: GAP FILL (Fill remaining empty cells with any available mesh)
-	int32 GapFillCount = FillRemainingGaps(FloorMeshes, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	int32 GapFillCount = FillRemainingGaps(FloorMeshes, *FloorPool, Stream, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
 	UE_LOG(LogTemp, Log, TEXT("  Phase 3:  Filled %d remaining gaps"), GapFillCount);
  
 	// FINAL STATISTICS
@@ -101,19 +114,24 @@ bool UUniformRoomGenerator::GenerateFloor()
 #pragma region Wall Generation
 bool UUniformRoomGenerator::GenerateWalls()
 {
+	FMemMark ScratchMark(FMemStack::Get());
+
 	if (!bIsInitialized)
 	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateWalls - Generator not initialized! ")); return false; }
 
 	if (!RoomData || RoomData->WallStyleData.IsNull())
 	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateWalls - WallStyleData not assigned!")); return false; }
 
-	WallData = RoomData->WallStyleData.LoadSynchronous();
-	if (!WallData || WallData->AvailableWallModules.Num() == 0)
+	WallData = RoomData->WallStyleData.Get();
+	if (!WallData)
+	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateWalls - WallStyleData is not loaded!")); return false; }
+
+	if (WallData->AvailableWallModules.Num() == 0)
 	{ UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateWalls - No wall modules defined!"));	return false; }
 	
 	// Clear previous data
 	ClearPlacedWalls();
-	PlacedBaseWallSegments.Empty();  // ✅ Clear tracking array
+	ResetBaseWallSegments();  // ✅ Clear tracking array and occupancy
 
 	UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateWalls - Starting wall generation"));
 
@@ -124,23 +142,23 @@ bool UUniformRoomGenerator::GenerateWalls()
 	else
 	{ UE_LOG(LogTemp, Log, TEXT("  Doorways generated:   %d"), PlacedDoorwayMeshes. Num()); }
 	
+	// Doorways drew from their own stage, walls get a fresh one
+	FRandomStream& Stream = BeginRandomStage(ERoomRandomStage::Walls);
+
 	// PHASE 1: FORCED WALL PLACEMENTS
 	int32 ForcedCount = ExecuteForcedWallPlacements();
 	if (ForcedCount > 0) UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced walls"), ForcedCount);
 	
 	// PHASE 2: Generate base walls for each edge
-	FillWallEdge(EWallEdge::North);
-	FillWallEdge(EWallEdge::South);
-	FillWallEdge(EWallEdge::East);
-	FillWallEdge(EWallEdge::West);
+	FillWallEdge(EWallEdge::North, Stream);
+	FillWallEdge(EWallEdge::South, Stream);
+	FillWallEdge(EWallEdge::East, Stream);
+	FillWallEdge(EWallEdge::West, Stream);
 
 	UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateWalls - Base walls tracked:  %d segments"), PlacedBaseWallSegments.Num());
 
-	// PASS 3: Spawn middle layers using socket-based stacking
-	SpawnMiddleWallLayers();
-
-	// PASS 4: Spawn top layer using socket-based stacking
-	SpawnTopWallLayer();
+	// PASS 3: Stack middle and top layers using socket-based stacking
+	StackWallLayers();
 
 	UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateWalls - Complete.  Total wall records: %d"), PlacedWallMeshes.Num());
 
@@ -157,9 +175,10 @@ bool UUniformRoomGenerator::GenerateCorners()
     if (! RoomData || RoomData->WallStyleData. IsNull())
     { UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator:: GenerateCorners - WallStyleData not assigned!")); return false; }
 
-    WallData = RoomData->WallStyleData.LoadSynchronous();
-    if (!WallData)
-    { UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateCorners - Failed to load WallStyleData!")); return false; }
+    // Local rather than the WallData member, corners may run while the walls stage uses it
+    const UWallData* WallStyle = RoomData->WallStyleData.Get();
+    if (!WallStyle)
+    { UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateCorners - WallStyleData is not loaded!")); return false; }
 
     // Clear previous corners
     ClearPlacedCorners();
@@ -167,15 +186,15 @@ bool UUniformRoomGenerator::GenerateCorners()
     UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateCorners - Starting corner generation"));
 
     // Load corner mesh (required)
-    if (WallData->DefaultCornerMesh.IsNull())
+    if (WallStyle->DefaultCornerMesh.IsNull())
     {
         UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCorners - No default corner mesh defined, skipping corners"));
         return true; 
     }
 
-    UStaticMesh* CornerMesh = WallData->DefaultCornerMesh.LoadSynchronous();
+    UStaticMesh* CornerMesh = WallStyle->DefaultCornerMesh.Get();
     if (!CornerMesh)
-    { UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCorners - Failed to load corner mesh")); return false;		}
+    { UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCorners - Corner mesh is not loaded")); return false;		}
 
      
     // Define corner data (matching MasterRoom's clockwise order:  SW, SE, NE, NW)
@@ -192,29 +211,29 @@ bool UUniformRoomGenerator::GenerateCorners()
         { 
             ECornerPosition::SouthWest, 
             FVector(0.0f, 0.0f, 0.0f),  // Bottom-left
-            WallData->SouthWestCornerRotation, 
-            WallData->SouthWestCornerOffset,
+            WallStyle->SouthWestCornerRotation, 
+            WallStyle->SouthWestCornerOffset,
             TEXT("SouthWest")
         },
         { 
             ECornerPosition::SouthEast, 
             FVector(0.0f, GridSize.Y * CellSize, 0.0f),  // Bottom-right
-            WallData->SouthEastCornerRotation, 
-            WallData->SouthEastCornerOffset,
+            WallStyle->SouthEastCornerRotation, 
+            WallStyle->SouthEastCornerOffset,
             TEXT("SouthEast")
         },
         { 
             ECornerPosition::NorthEast, 
             FVector(GridSize.X * CellSize, GridSize.Y * CellSize, 0.0f),  // Top-right
-            WallData->NorthEastCornerRotation, 
-            WallData->NorthEastCornerOffset,
+            WallStyle->NorthEastCornerRotation, 
+            WallStyle->NorthEastCornerOffset,
             TEXT("NorthEast")
         },
         { 
             ECornerPosition:: NorthWest, 
             FVector(GridSize.X * CellSize, 0.0f, 0.0f),  // Top-left
-            WallData->NorthWestCornerRotation, 
-            WallData->NorthWestCornerOffset,
+            WallStyle->NorthWestCornerRotation, 
+            WallStyle->NorthWestCornerOffset,
             TEXT("NorthWest")
         }
     };
@@ -231,10 +250,11 @@ bool UUniformRoomGenerator::GenerateCorners()
         // Create placed corner info
         FPlacedCornerInfo PlacedCorner;
         PlacedCorner.Corner = CornerData. Position;
-        PlacedCorner.CornerMesh = WallData->DefaultCornerMesh;
+        PlacedCorner.CornerMesh = WallStyle->DefaultCornerMesh;
         PlacedCorner.Transform = CornerTransform;
 
         PlacedCornerMeshes.Add(PlacedCorner);
+        PublishPlacement(ERoomMeshCategory::Corner, PlacedCorner.CornerMesh, PlacedCorner.Transform);
 
         UE_LOG(LogTemp, Verbose, TEXT("  Placed %s corner at position %s with rotation (%.0f, %.0f, %.0f)"),
         *CornerData.Name,  *FinalPosition.ToString(), CornerData. Rotation.Roll, CornerData.Rotation. Pitch, CornerData.Rotation.Yaw);
@@ -283,6 +303,7 @@ bool UUniformRoomGenerator::GenerateDoorways()
     // Clear both layout and transforms
     PlacedDoorwayMeshes.Empty();
     CachedDoorwayLayouts.Empty();
+    FRandomStream& Stream = BeginRandomStage(ERoomRandomStage::Doorways);
 
     int32 ManualDoorwaysPlaced = 0;
     int32 AutomaticDoorwaysPlaced = 0;
@@ -301,7 +322,7 @@ bool UUniformRoomGenerator::GenerateDoorways()
     	UE_LOG(LogTemp, Log, TEXT("  Manual doorway:  Edge=%s, FrameFootprint=%d, SideFills=%s, TotalWidth=%d"),
     	*UEnum::GetValueAsString(ForcedDoor.WallEdge), DoorData->FrameFootprintY, *UEnum:: GetValueAsString(DoorData->SideFillType), DoorWidth);
         // Validate bounds
-        TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(ForcedDoor.WallEdge, GridSize);
+        const FEdgeCellView EdgeCells = URoomGenerationHelpers::GetEdgeCellView(ForcedDoor.WallEdge, GridSize);
         
         if (ForcedDoor.StartCell < 0 || ForcedDoor.StartCell + DoorWidth > EdgeCells.Num())
         { UE_LOG(LogTemp, Warning, TEXT("  Forced doorway out of bounds, skipping")); continue; }
@@ -341,7 +362,6 @@ bool UUniformRoomGenerator::GenerateDoorways()
             
             TArray<EWallEdge> AllEdges = { EWallEdge:: North, EWallEdge::  South, EWallEdge:: East, EWallEdge:: West };
             
-            FRandomStream Stream(FMath:: Rand());
             for (int32 i = AllEdges.Num() - 1; i > 0; --i)
             {
                 int32 j = Stream.RandRange(0, i);
@@ -357,7 +377,6 @@ bool UUniformRoomGenerator::GenerateDoorways()
         }
         else
         {
-            FRandomStream Stream(FMath::Rand());
             TArray<EWallEdge> AllEdges = 
             { EWallEdge::North, EWallEdge::South, 
 				EWallEdge:: East, EWallEdge:: West 
@@ -371,7 +390,7 @@ bool UUniformRoomGenerator::GenerateDoorways()
         // Generate doorway on each chosen edge
         for (EWallEdge ChosenEdge : EdgesToUse)
         {
-            TArray<FIntPoint> EdgeCells = URoomGenerationHelpers::GetEdgeCellIndices(ChosenEdge, GridSize);
+            const FEdgeCellView EdgeCells = URoomGenerationHelpers::GetEdgeCellView(ChosenEdge, GridSize);
             int32 EdgeLength = EdgeCells.Num();
 
             int32 StartCell = (EdgeLength - RoomData->StandardDoorwayWidth) / 2;
@@ -432,15 +451,17 @@ bool UUniformRoomGenerator::GenerateDoorways()
 #pragma region Ceiling Generation
 bool UUniformRoomGenerator::GenerateCeiling()
 {
+	FMemMark ScratchMark(FMemStack::Get());
+
 	 if (! bIsInitialized)
     { UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateCeiling - Generator not initialized!  ")); return false; }
 
     if (! RoomData || RoomData->CeilingStyleData.IsNull())
     { UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCeiling - No CeilingStyleData assigned")); return false; }
 
-    CeilingData = RoomData->CeilingStyleData.LoadSynchronous();
+    CeilingData = RoomData->CeilingStyleData.Get();
     if (!CeilingData)
-    { UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateCeiling - Failed to load CeilingStyleData")); return false; }
+    { UE_LOG(LogTemp, Error, TEXT("UUniformRoomGenerator::GenerateCeiling - CeilingStyleData is not loaded")); return false; }
 
 	if (CeilingData->CeilingTilePool.Num() == 0)
 	{ UE_LOG(LogTemp, Warning, TEXT("UUniformRoomGenerator::GenerateCeiling - No tiles in CeilingTilePool! ")); return false; }
@@ -451,120 +472,63 @@ bool UUniformRoomGenerator::GenerateCeiling()
     UE_LOG(LogTemp, Log, TEXT("UUniformRoomGenerator::GenerateCeiling - Starting ceiling generation"));
 
     // Create occupancy grid
-    TArray<bool> CeilingOccupied;
-    CeilingOccupied.Init(false, GridSize.X * GridSize.Y);
+    CeilingKernel.Reset(GridSize, EKernelCellType::ECT_Empty);
 
-    FRandomStream Stream(FMath::  Rand());
+    FRandomStream& Stream = BeginRandomStage(ERoomRandomStage::Ceiling);
+    const TSharedRef<const FKernelTilePool, ESPMode::ThreadSafe> CeilingPool = CeilingData->GetCompiledCeilingTilePool();
 
     int32 CeilingLargeTilesPlaced = 0;
     int32 CeilingMediumTilesPlaced = 0;
     int32 CeilingSmallTilesPlaced = 0;
 	int32 CeilingFillerTilesPlaced = 0; 
-     
-    // HELPER LAMBDAS
-     
-
-    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
-    {
-        if (X < 0 || X >= GridSize.X || Y < 0 || Y >= GridSize.Y) return true;
-        return CeilingOccupied[Y * GridSize.X + X];
-    };
-
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                if (X >= 0 && X < GridSize.X && Y >= 0 && Y < GridSize.Y)
-                {
-                    CeilingOccupied[Y * GridSize.X + X] = true;
-                }
-            }
-        }
-    };
-
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                if (IsCellOccupied(StartX + dx, StartY + dy))
-                    return false;
-            }
-        }
-        return true;
-    };
 
 	// PHASE 0:  FORCED PLACEMENTS (Designer overrides - highest priority)
-	int32 ForcedCount = ExecuteForcedCeilingPlacements(CeilingOccupied);
+	int32 ForcedCount = ExecuteForcedCeilingPlacements();
 	if (ForcedCount > 0)
 	{ UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced ceiling tiles"), ForcedCount); }
 	
     // PASS 1:  LARGE TILES (4x4)
 	// Large tiles (400x400, 200x400, 400x200)
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(4, 4), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingLargeTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(2, 4), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingLargeTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(4, 2), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingLargeTilesPlaced);
+	FillCeilingWithTileSize(CeilingData->CeilingTilePool, *CeilingPool, FIntPoint(4, 4), Stream, CeilingLargeTilesPlaced);
+	FillCeilingWithTileSize(CeilingData->CeilingTilePool, *CeilingPool, FIntPoint(2, 4), Stream, CeilingLargeTilesPlaced);
+	FillCeilingWithTileSize(CeilingData->CeilingTilePool, *CeilingPool, FIntPoint(4, 2), Stream, CeilingLargeTilesPlaced);
 
 	// Medium tiles (200x200)
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(2, 2), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingMediumTilesPlaced);
+	FillCeilingWithTileSize(CeilingData->CeilingTilePool, *CeilingPool, FIntPoint(2, 2), Stream, CeilingMediumTilesPlaced);
 
 	// Small tiles (100x200, 200x100, 100x100)
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(1, 2), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingSmallTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(2, 1), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingSmallTilesPlaced);
-	FillCeilingWithTileSize(CeilingData->CeilingTilePool, CeilingOccupied, FIntPoint(1, 1), CeilingData->CeilingRotation, CeilingData->CeilingHeight, CeilingSmallTilesPlaced);
+	FillCeilingWithTileSize(CeilingData->CeilingTilePool, *CeilingPool, FIntPoint(1, 2), Stream, CeilingSmallTilesPlaced);
+	FillCeilingWithTileSize(CeilingData->CeilingTilePool, *CeilingPool, FIntPoint(2, 1), Stream, CeilingSmallTilesPlaced);
+	FillCeilingWithTileSize(CeilingData->CeilingTilePool, *CeilingPool, FIntPoint(1, 1), Stream, CeilingSmallTilesPlaced);
 
 
      
     // PASS 2:  MEDIUM TILES (2x2)
-	int32 GapFillCount = FillRemainingCeilingGaps(CeilingData->CeilingTilePool, CeilingOccupied, CeilingData->CeilingRotation, CeilingData->CeilingHeight,
+	int32 GapFillCount = FillRemainingCeilingGaps(CeilingData->CeilingTilePool, *CeilingPool, Stream,
 	  CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, CeilingFillerTilesPlaced);
 	UE_LOG(LogTemp, Log, TEXT("  Phase 2: Filled %d remaining gaps"), GapFillCount);
      
     // PASS 3:  SMALL TILES (1x1)
 	if (CeilingData->CeilingTilePool.Num() > 0)
     {
+        // Build the weighted table once instead of rescanning the pool per cell
+        FKernelAliasTable CeilingTileTable;
+        URoomGenerationHelpers::BuildMeshPlacementAliasTable(CeilingData->CeilingTilePool, CeilingTileTable);
+
         for (int32 Y = 0; Y < GridSize.Y; Y++)
         {
             for (int32 X = 0; X < GridSize.X; X++)
             {
-                if (!  IsCellOccupied(X, Y))
+                if (CeilingKernel.GetCell(FIntPoint(X, Y)) == EKernelCellType::ECT_Empty)
                 {
-                	FMeshPlacementInfo SelectedTile = SelectWeightedMesh(CeilingData->CeilingTilePool);
+                	const FMeshPlacementInfo& SelectedTile = CeilingData->CeilingTilePool[CeilingTileTable.Sample(Stream)];
 
                     if (SelectedTile.MeshAsset.IsNull())
                     {
                         // ✅ CHANGED:   Use GridFootprint from tile
                         FIntPoint TileFootprint = SelectedTile.GridFootprint;
-                        
-                        FVector TilePosition = FVector(
-                            (X + TileFootprint.X / 2.0f) * CellSize,
-                            (Y + TileFootprint.Y / 2.0f) * CellSize,
-                            CeilingData->CeilingHeight
-                        );
-
-                    	// Create rotation (base ceiling rotation + tile rotation)
-                    	FRotator FinalRotation = CeilingData->CeilingRotation;
-
-                    	// Normalize quaternion to avoid floating point errors
-                    	FQuat NormalizedRotation = FinalRotation.Quaternion();
-                    	NormalizedRotation.Normalize();
-
-                    	// Create transform
-                    	FTransform TileTransform(NormalizedRotation, TilePosition, FVector(1.0f));
-
-                        FPlacedCeilingInfo PlacedTile;
-                        PlacedTile. GridCoordinate = FIntPoint(X, Y);
-                        PlacedTile.TileSize = TileFootprint;
-                        PlacedTile.MeshInfo = SelectedTile;
-                         PlacedTile.LocalTransform = TileTransform;
-
-                        PlacedCeilingTiles.Add(PlacedTile);
-                        MarkCellsOccupied(X, Y, TileFootprint);
+                        RecordCeilingPlacement(FIntPoint(X, Y), TileFootprint, SelectedTile, 0);
+                        CeilingKernel.MarkArea(FIntPoint(X, Y), TileFootprint, EKernelCellType::ECT_FloorMesh);
                         CeilingSmallTilesPlaced++;
                     }
                 }
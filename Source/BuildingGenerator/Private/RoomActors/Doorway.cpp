@@ -5,7 +5,10 @@
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SceneComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
 
 ADoorway::ADoorway()
 {
@@ -70,6 +73,7 @@ void ADoorway::BeginPlay()
 void ADoorway::InitializeDoorway(UDoorData* InDoorData, EWallEdge InWallEdge, bool bInIsStandard)
 {
     DoorData = InDoorData;
+    DoorMeshHandle.Reset();
     WallEdge = InWallEdge;
     bIsStandardDoorway = bInIsStandard;
 
@@ -87,11 +91,24 @@ void ADoorway::SetupVisuals()
         return;
     }
 
+    // Rooms stream door meshes with their other assets, anything still missing is streamed here and set up on arrival
+    if (!DoorMeshHandle.IsValid())
+    {
+        TArray<FSoftObjectPath> MeshPaths;
+        URoomGenerationHelpers::GatherDoorMeshAssets(DoorData, MeshPaths);
+        if (MeshPaths.Num() > 0)
+        {
+            DoorMeshHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(MeshPaths),
+                FStreamableDelegate::CreateUObject(this, &ADoorway::SetupVisuals));
+        }
+    }
+    if (DoorMeshHandle.IsValid() && DoorMeshHandle->IsLoadingInProgress()) return;
+
     // ========================================================================
     // SETUP DOOR FRAME
     // ========================================================================
 
-    UStaticMesh* FrameMesh = DoorData->FrameSideMesh. LoadSynchronous();
+    UStaticMesh* FrameMesh = URoomGenerationHelpers::LoadAndValidateMesh(DoorData->FrameSideMesh, TEXT("DoorFrame"), false);
     if (FrameMesh)
     {
         FrameMeshComponent->SetStaticMesh(FrameMesh);
@@ -143,8 +160,8 @@ void ADoorway::SetupSideFills()
     {
         case EDoorwaySideFill::CustomMeshes:
         {
-            // Load left side mesh
-            UStaticMesh* LeftMesh = DoorData->LeftSideMesh.LoadSynchronous();
+            // Resolve left side mesh (streamed with the room assets)
+            UStaticMesh* LeftMesh = URoomGenerationHelpers::LoadAndValidateMesh(DoorData->LeftSideMesh, TEXT("DoorLeftSide"), false);
             if (LeftMesh)
             {
                 LeftSideMeshComponent->SetStaticMesh(LeftMesh);
@@ -158,8 +175,8 @@ void ADoorway::SetupSideFills()
                 LeftSideMeshComponent->SetVisibility(false);
             }
 
-            // Load right side mesh
-            UStaticMesh* RightMesh = DoorData->RightSideMesh. LoadSynchronous();
+            // Resolve right side mesh (streamed with the room assets)
+            UStaticMesh* RightMesh = URoomGenerationHelpers::LoadAndValidateMesh(DoorData->RightSideMesh, TEXT("DoorRightSide"), false);
             if (RightMesh)
             {
                 RightSideMeshComponent->SetStaticMesh(RightMesh);
@@ -0,0 +1,261 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Spawners/Building/BuildingInstancePool.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
+
+UBuildingInstancePool::UBuildingInstancePool()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+#pragma region Instance Ranges
+int32 UBuildingInstancePool::AddInstanceRange(const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+	const FTransform& RangeTransform, bool bInstanceCollision)
+{
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{ UE_LOG(LogTemp, Error, TEXT("UBuildingInstancePool::AddInstanceRange - Pool has no owner!")); return INDEX_NONE; }
+
+	if (Batches.Num() == 0) return INDEX_NONE;
+
+	// Components sit at the owner's origin, so batches are moved from range space into owner space
+	const FTransform RangeToPool = RangeTransform.GetRelativeTransform(Owner->GetActorTransform());
+
+	const int32 RangeHandle = Ranges.Add(FBuildingInstanceRange());
+	FBuildingInstanceRange& Range = Ranges[RangeHandle];
+	Range.RangeToPool = RangeToPool;
+
+	TArray<FTransform> PoolTransforms;
+	for (const TPair<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batch : Batches)
+	{
+		if (Batch.Value.Num() == 0) continue;
+
+		const int32 PoolIndex = GetOrCreateMeshPool(Batch.Key, bInstanceCollision);
+		if (PoolIndex == INDEX_NONE) continue;
+
+		PoolTransforms.Reset(Batch.Value.Num());
+		for (const FTransform& LocalTransform : Batch.Value) { PoolTransforms.Add(LocalTransform * RangeToPool); }
+
+		const int32 EntryIndex = Range.Entries.Num();
+		Range.Entries.AddDefaulted_GetRef().MeshPool = PoolIndex;
+		AddEntryInstances(RangeHandle, EntryIndex, PoolTransforms);
+	}
+
+	if (Range.Entries.Num() == 0) { Ranges.RemoveAt(RangeHandle); return INDEX_NONE; }
+	return RangeHandle;
+}
+
+bool UBuildingInstancePool::RemoveInstanceRange(int32 RangeHandle)
+{
+	if (!Ranges.IsValidIndex(RangeHandle))
+	{ UE_LOG(LogTemp, Warning, TEXT("UBuildingInstancePool::RemoveInstanceRange - Unknown range %d"), RangeHandle); return false; }
+
+	for (FBuildingRangeEntry& Entry : Ranges[RangeHandle].Entries) { RemoveEntryInstances(Entry); }
+
+	Ranges.RemoveAt(RangeHandle);
+	return true;
+}
+
+int32 UBuildingInstancePool::ReplaceInstanceRange(int32& RangeHandle, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+	const FTransform& RangeTransform, bool bInstanceCollision)
+{
+	if (RangeHandle != INDEX_NONE) RemoveInstanceRange(RangeHandle);
+
+	RangeHandle = AddInstanceRange(Batches, RangeTransform, bInstanceCollision);
+	return GetRangeInstanceCount(RangeHandle);
+}
+
+bool UBuildingInstancePool::SetInstanceRangeTransform(int32 RangeHandle, const FTransform& RangeTransform)
+{
+	if (!Ranges.IsValidIndex(RangeHandle))
+	{ UE_LOG(LogTemp, Warning, TEXT("UBuildingInstancePool::SetInstanceRangeTransform - Unknown range %d"), RangeHandle); return false; }
+
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{ UE_LOG(LogTemp, Error, TEXT("UBuildingInstancePool::SetInstanceRangeTransform - Pool has no owner!")); return false; }
+
+	// Moving the whole building keeps the range where it is relative to the components
+	FBuildingInstanceRange& Range = Ranges[RangeHandle];
+	const FTransform RangeToPool = RangeTransform.GetRelativeTransform(Owner->GetActorTransform());
+	if (RangeToPool.Equals(Range.RangeToPool)) return true;
+
+	// Back into range space with the old placement, out again with the new one
+	const FTransform Delta = Range.RangeToPool.Inverse() * RangeToPool;
+	Range.RangeToPool = RangeToPool;
+
+	for (FBuildingRangeEntry& Entry : Range.Entries)
+	{
+		UInstancedStaticMeshComponent* ISM = MeshPools[Entry.MeshPool].Component;
+		if (!IsValid(ISM)) continue;
+
+		for (int32 Slot = 0; Slot < Entry.Instances.Num(); ++Slot)
+		{
+			FTransform InstanceTransform;
+			ISM->GetInstanceTransform(Entry.Instances[Slot], InstanceTransform, false);
+			ISM->UpdateInstanceTransform(Entry.Instances[Slot], InstanceTransform * Delta, false, false, true);
+		}
+		for (FTransform& HiddenTransform : Entry.HiddenTransforms) { HiddenTransform = HiddenTransform * Delta; }
+		ISM->MarkRenderStateDirty();
+	}
+
+	return true;
+}
+
+bool UBuildingInstancePool::SetInstanceRangeHidden(int32 RangeHandle, bool bHidden)
+{
+	if (!Ranges.IsValidIndex(RangeHandle))
+	{ UE_LOG(LogTemp, Warning, TEXT("UBuildingInstancePool::SetInstanceRangeHidden - Unknown range %d"), RangeHandle); return false; }
+
+	FBuildingInstanceRange& Range = Ranges[RangeHandle];
+	if (Range.bHidden == bHidden) return true;
+	Range.bHidden = bHidden;
+
+	// Hidden ranges leave their components entirely (one batched remove/add per component, no degenerate instances left to draw)
+	for (int32 EntryIndex = 0; EntryIndex < Range.Entries.Num(); ++EntryIndex)
+	{
+		FBuildingRangeEntry& Entry = Range.Entries[EntryIndex];
+		UInstancedStaticMeshComponent* ISM = MeshPools[Entry.MeshPool].Component;
+		if (!IsValid(ISM)) continue;
+
+		if (bHidden)
+		{
+			Entry.HiddenTransforms.SetNum(Entry.Instances.Num());
+			for (int32 Slot = 0; Slot < Entry.Instances.Num(); ++Slot)
+			{
+				ISM->GetInstanceTransform(Entry.Instances[Slot], Entry.HiddenTransforms[Slot], false);
+			}
+			RemoveEntryInstances(Entry);
+		}
+		else
+		{
+			AddEntryInstances(RangeHandle, EntryIndex, Entry.HiddenTransforms);
+			Entry.HiddenTransforms.Empty();
+		}
+	}
+
+	return true;
+}
+
+int32 UBuildingInstancePool::GetRangeInstanceCount(int32 RangeHandle) const
+{
+	if (!Ranges.IsValidIndex(RangeHandle)) return 0;
+
+	int32 Count = 0;
+	for (const FBuildingRangeEntry& Entry : Ranges[RangeHandle].Entries) { Count += Entry.Instances.Num(); }
+	return Count;
+}
+
+void UBuildingInstancePool::ClearPool()
+{
+	for (const FBuildingMeshPool& Pool : MeshPools)
+	{
+		if (IsValid(Pool.Component)) Pool.Component->DestroyComponent();
+	}
+
+	MeshPools.Empty();
+	MeshPoolLookup.Empty();
+	Ranges.Empty();
+}
+#pragma endregion
+
+#pragma region Statistics
+int32 UBuildingInstancePool::GetTotalInstanceCount() const
+{
+	int32 Count = 0;
+	for (const FBuildingMeshPool& Pool : MeshPools) { Count += Pool.Owners.Num(); }
+	return Count;
+}
+#pragma endregion
+
+void UBuildingInstancePool::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+	ClearPool();
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+void UBuildingInstancePool::AddEntryInstances(int32 RangeHandle, int32 EntryIndex, const TArray<FTransform>& PoolTransforms)
+{
+	FBuildingRangeEntry& Entry = Ranges[RangeHandle].Entries[EntryIndex];
+	FBuildingMeshPool& Pool = MeshPools[Entry.MeshPool];
+	Entry.Instances = Pool.Component->AddInstances(PoolTransforms, true, false);
+
+	for (int32 Slot = 0; Slot < Entry.Instances.Num(); ++Slot)
+	{
+		const int32 InstanceIndex = Entry.Instances[Slot];
+		if (InstanceIndex >= Pool.Owners.Num()) Pool.Owners.SetNum(InstanceIndex + 1);
+		Pool.Owners[InstanceIndex] = { RangeHandle, EntryIndex, Slot };
+	}
+}
+
+void UBuildingInstancePool::RemoveEntryInstances(FBuildingRangeEntry& Entry)
+{
+	FBuildingMeshPool& Pool = MeshPools[Entry.MeshPool];
+	UInstancedStaticMeshComponent* ISM = Pool.Component;
+	if (!IsValid(ISM) || Entry.Instances.Num() == 0) return;
+
+	// Highest index first: the last instance is then never one of ours, so it can fill the hole
+	TArray<int32> Removed = MoveTemp(Entry.Instances);
+	Entry.Instances.Reset();
+	Removed.Sort(TGreater<int32>());
+
+	int32 Count = Pool.Owners.Num();
+	for (const int32 Index : Removed)
+	{
+		const int32 Last = --Count;
+		if (Index == Last) continue;
+
+		FTransform MovedTransform;
+		ISM->GetInstanceTransform(Last, MovedTransform, false);
+		ISM->UpdateInstanceTransform(Index, MovedTransform, false, false, true);
+
+		const FBuildingInstanceOwner Moved = Pool.Owners[Last];
+		Pool.Owners[Index] = Moved;
+		Ranges[Moved.Range].Entries[Moved.Entry].Instances[Moved.Slot] = Index;
+	}
+
+	// Only the tail is removed, which keeps every remaining index stable
+	TArray<int32> Tail;
+	Tail.Reserve(Removed.Num());
+	for (int32 Index = Pool.Owners.Num() - 1; Index >= Count; --Index) { Tail.Add(Index); }
+	ISM->RemoveInstances(Tail);
+	ISM->MarkRenderStateDirty();
+	Pool.Owners.SetNum(Count);
+}
+
+int32 UBuildingInstancePool::GetOrCreateMeshPool(const TSoftObjectPtr<UStaticMesh>& MeshAsset, bool bInstanceCollision)
+{
+	// Collision is per component, so the same mesh gets one pool with instance bodies and one without
+	const TPair<TSoftObjectPtr<UStaticMesh>, bool> PoolKey(MeshAsset, bInstanceCollision);
+	if (const int32* Existing = MeshPoolLookup.Find(PoolKey))
+	{
+		if (IsValid(MeshPools[*Existing].Component)) return *Existing;
+		UE_LOG(LogTemp, Warning, TEXT("UBuildingInstancePool::GetOrCreateMeshPool - Component for %s was destroyed"), *MeshAsset.GetAssetName());
+		return INDEX_NONE;
+	}
+
+	AActor* Owner = GetOwner();
+	UStaticMesh* StaticMesh = URoomGenerationHelpers::LoadAndValidateMesh(MeshAsset, TEXT("PooledISM_"), true);
+	if (!Owner || !StaticMesh) return INDEX_NONE;
+
+	const TSubclassOf<UInstancedStaticMeshComponent> ComponentClass = bUseHierarchicalInstances
+		? UHierarchicalInstancedStaticMeshComponent::StaticClass() : UInstancedStaticMeshComponent::StaticClass();
+	const FName ComponentName = MakeUniqueObjectName(Owner, ComponentClass, FName(*FString::Printf(TEXT("PooledISM_%s%s"),
+		*MeshAsset.GetAssetName(), bInstanceCollision ? TEXT("_Collision") : TEXT(""))));
+
+	UInstancedStaticMeshComponent* NewISM = NewObject<UInstancedStaticMeshComponent>(Owner, ComponentClass, ComponentName);
+	NewISM->RegisterComponent();
+	NewISM->AttachToComponent(Owner->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	NewISM->SetRelativeTransform(FTransform::Identity);
+	NewISM->SetStaticMesh(StaticMesh);
+	NewISM->SetCollisionEnabled(bInstanceCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+
+	FBuildingMeshPool& Pool = MeshPools.AddDefaulted_GetRef();
+	Pool.Component = NewISM;
+
+	const int32 PoolIndex = MeshPools.Num() - 1;
+	MeshPoolLookup.Add(PoolKey, PoolIndex);
+	return PoolIndex;
+}
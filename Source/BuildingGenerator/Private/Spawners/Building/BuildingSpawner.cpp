@@ -2,6 +2,13 @@
 
 
 #include "Spawners/Building/BuildingSpawner.h"
+#include "Spawners/Building/BuildingInstancePool.h"
+#include "Camera/PlayerCameraManager.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "Generators/Rooms/RoomGenerator.h"
+#include "Spawners/Rooms/RoomSpawner.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
 
 
 // Sets default values
@@ -9,18 +16,190 @@ ABuildingSpawner::ABuildingSpawner()
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+
+	SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+	RootComponent = SceneRoot;
+
+	InstancePool = CreateDefaultSubobject<UBuildingInstancePool>(TEXT("InstancePool"));
 }
 
 // Called when the game starts or when spawned
 void ABuildingSpawner::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	RebuildPortalGraph();
 }
 
 // Called every frame
 void ABuildingSpawner::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	if (!bEnablePortalCulling)
+	{
+		if (bRoomsCulled) ShowAllRooms();
+		return;
+	}
+
+	if (bPortalGraphDirty) RebuildPortalGraph();
+	UpdatePortalVisibility();
+}
+
+#pragma region Portal Culling
+void ABuildingSpawner::RebuildPortalGraph()
+{
+	// Rooms may have left the building since the last build
+	ShowAllRooms();
+
+	PortalRooms.Reset();
+	Portals.Reset();
+	RoomPortals.Reset();
+	bPortalGraphDirty = false;
+
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	for (TActorIterator<ARoomSpawner> It(World); It; ++It)
+	{
+		if (It->OwningBuilding == this && It->GetRoomGenerator()) PortalRooms.Add(*It);
+	}
+	RoomPortals.SetNum(PortalRooms.Num());
+
+	// Every doorway opening in world XY, tagged with its room
+	struct FDoorwayOpening { int32 Room; FVector2D Start; FVector2D End; };
+	TArray<FDoorwayOpening> Openings;
+	for (int32 RoomIndex = 0; RoomIndex < PortalRooms.Num(); ++RoomIndex)
+	{
+		const ARoomSpawner* Room = PortalRooms[RoomIndex].Get();
+		const URoomGenerator* Generator = Room->GetRoomGenerator();
+		const FTransform RoomTransform = Room->GetActorTransform();
+
+		for (const FPlacedDoorwayInfo& Doorway : Generator->GetPlacedDoorways())
+		{
+			FVector Start, End;
+			URoomGenerationHelpers::CalculateDoorwayOpening(Doorway.Edge, Doorway.StartCell, Doorway.WidthInCells,
+				Generator->GetGridSize(), Generator->GetCellSize(), Start, End);
+			Openings.Add({ RoomIndex, FVector2D(RoomTransform.TransformPosition(Start)), FVector2D(RoomTransform.TransformPosition(End)) });
+		}
+	}
+
+	// Doorways of neighbouring rooms overlap on the shared wall, unmatched ones lead outside
+	const double ToleranceSquared = FMath::Square(PortalMatchTolerance);
+	for (int32 A = 0; A < Openings.Num(); ++A)
+	{
+		const FVector2D CenterA = (Openings[A].Start + Openings[A].End) * 0.5;
+		for (int32 B = A + 1; B < Openings.Num(); ++B)
+		{
+			if (Openings[A].Room == Openings[B].Room) continue;
+
+			const FVector2D CenterB = (Openings[B].Start + Openings[B].End) * 0.5;
+			if (FVector2D::DistSquared(CenterA, CenterB) > ToleranceSquared) continue;
+
+			const int32 PortalIndex = Portals.Add({ Openings[A].Room, Openings[B].Room, Openings[A].Start, Openings[A].End });
+			RoomPortals[Openings[A].Room].Add(PortalIndex);
+			RoomPortals[Openings[B].Room].Add(PortalIndex);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ABuildingSpawner::RebuildPortalGraph - %d rooms, %d portals"), PortalRooms.Num(), Portals.Num());
+}
+
+void ABuildingSpawner::UpdatePortalVisibility()
+{
+	UWorld* World = GetWorld();
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PlayerController || !PlayerController->PlayerCameraManager || PortalRooms.Num() == 0) return;
+
+	const APlayerCameraManager* Camera = PlayerController->PlayerCameraManager;
+	const FVector ViewLocation = Camera->GetCameraLocation();
+
+	// Highest room floor below the camera wins when rooms are stacked
+	int32 CameraRoom = INDEX_NONE;
+	for (int32 RoomIndex = 0; RoomIndex < PortalRooms.Num(); ++RoomIndex)
+	{
+		const ARoomSpawner* Room = PortalRooms[RoomIndex].Get();
+		if (!Room || !Room->ContainsWorldPoint(ViewLocation)) continue;
+		if (CameraRoom == INDEX_NONE || Room->GetActorLocation().Z > PortalRooms[CameraRoom]->GetActorLocation().Z) CameraRoom = RoomIndex;
+	}
+
+	// Outside the building every room may be seen through windows and exterior doorways
+	if (CameraRoom == INDEX_NONE)
+	{
+		if (bRoomsCulled) ShowAllRooms();
+		return;
+	}
+
+	// Horizontal pass only (rooms of a floor share their height), so the view window is the horizontal FOV
+	const FVector2D ViewOrigin(ViewLocation);
+	const FVector2D ViewDirection = FVector2D(Camera->GetCameraRotation().Vector()).GetSafeNormal();
+	const double HalfFOV = FMath::DegreesToRadians(Camera->GetFOVAngle() * 0.5);
+
+	TBitArray<> Visible(false, PortalRooms.Num());
+	TBitArray<> OnPath(false, PortalRooms.Num());
+	Visible[CameraRoom] = true;
+	OnPath[CameraRoom] = true;
+
+	// Looking straight up or down: no horizontal direction to narrow, show direct neighbours only
+	if (ViewDirection.IsNearlyZero()) FlowThroughPortals(CameraRoom, ViewOrigin, FVector2D(1.0, 0.0), -PI, PI, MaxPortalDepth - 1, Visible, OnPath);
+	else FlowThroughPortals(CameraRoom, ViewOrigin, ViewDirection, -HalfFOV, HalfFOV, 0, Visible, OnPath);
+
+	for (int32 RoomIndex = 0; RoomIndex < PortalRooms.Num(); ++RoomIndex)
+	{
+		if (ARoomSpawner* Room = PortalRooms[RoomIndex].Get()) Room->SetRoomMeshesVisible(Visible[RoomIndex]);
+	}
+	bRoomsCulled = true;
+}
+
+void ABuildingSpawner::FlowThroughPortals(int32 RoomIndex, const FVector2D& ViewOrigin, const FVector2D& ViewDirection,
+	double MinAngle, double MaxAngle, int32 Depth, TBitArray<>& OutVisible, TBitArray<>& OnPath) const
+{
+	if (Depth >= MaxPortalDepth) return;
+
+	// Signed angle of a point from the view direction (positive = clockwise seen from above, like yaw)
+	auto AngleTo = [&ViewOrigin, &ViewDirection](const FVector2D& Point)
+	{
+		const FVector2D ToPoint = Point - ViewOrigin;
+		return FMath::Atan2(FVector2D::CrossProduct(ViewDirection, ToPoint), FVector2D::DotProduct(ViewDirection, ToPoint));
+	};
+
+	for (const int32 PortalIndex : RoomPortals[RoomIndex])
+	{
+		const FBuildingPortal& Portal = Portals[PortalIndex];
+		const int32 NextRoom = Portal.RoomA == RoomIndex ? Portal.RoomB : Portal.RoomA;
+		if (OnPath[NextRoom]) continue;
+
+		double PortalMin = MinAngle;
+		double PortalMax = MaxAngle;
+
+		// Standing in the doorway (or a portal wrapping behind the camera) keeps the current window
+		const FVector2D Closest = FMath::ClosestPointOnSegment2D(ViewOrigin, Portal.Start, Portal.End);
+		if (FVector2D::DistSquared(Closest, ViewOrigin) > 1.0)
+		{
+			const double StartAngle = AngleTo(Portal.Start);
+			const double EndAngle = AngleTo(Portal.End);
+			if (FMath::Abs(StartAngle - EndAngle) < PI)
+			{
+				PortalMin = FMath::Max(MinAngle, FMath::Min(StartAngle, EndAngle));
+				PortalMax = FMath::Min(MaxAngle, FMath::Max(StartAngle, EndAngle));
+			}
+		}
+		if (PortalMin >= PortalMax) continue;
+
+		OutVisible[NextRoom] = true;
+		OnPath[NextRoom] = true;
+		FlowThroughPortals(NextRoom, ViewOrigin, ViewDirection, PortalMin, PortalMax, Depth + 1, OutVisible, OnPath);
+		OnPath[NextRoom] = false;
+	}
+}
+
+void ABuildingSpawner::ShowAllRooms()
+{
+	for (const TWeakObjectPtr<ARoomSpawner>& Room : PortalRooms)
+	{
+		if (Room.IsValid()) Room->SetRoomMeshesVisible(true);
+	}
+	bRoomsCulled = false;
 }
+#pragma endregion
 
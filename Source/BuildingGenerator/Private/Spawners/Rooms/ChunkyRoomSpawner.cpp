@@ -25,7 +25,7 @@ bool AChunkyRoomSpawner::EnsureGeneratorReady()
 	// Initialize if needed
 	if (!ChunkyGen->IsInitialized())
 	{
-		if (!ChunkyGen->Initialize(RoomData, RoomGridSize)) { /* error */ return false; }        
+		if (!ChunkyGen->Initialize(RoomData, RoomGridSize, RoomSeed)) { /* error */ return false; }        
 		ChunkyGen->CreateGrid();
 	}
     
@@ -0,0 +1,321 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Spawners/Rooms/RoomGenerationJob.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Generators/Rooms/RoomGenerator.h"
+#include "UObject/GarbageCollection.h"
+#include "Utilities/Generation/RoomGenerationHelpers.h"
+
+namespace
+{
+	constexpr int32 NumMeshCategories = 4;
+}
+
+bool URoomGenerationJob::Start(ARoomSpawner* InRoom)
+{
+	if (!IsValid(InRoom))
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerationJob::Start - Room is invalid!")); return false; }
+
+	if (!InRoom->RoomData)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerationJob::Start - %s has no RoomData!"), *InRoom->GetName()); return false; }
+
+	Room = InRoom;
+	Phase = ERoomGenerationPhase::LoadingStyles;
+	SpawnCategory = 0;
+	bCategoryGathered = false;
+	CategoryBatches.Reset();
+	return true;
+}
+
+void URoomGenerationJob::Cancel()
+{
+	if (Phase >= ERoomGenerationPhase::Finished) return;
+
+	if (StyleAssetHandle.IsValid() && StyleAssetHandle->IsLoadingInProgress()) StyleAssetHandle->CancelHandle();
+	if (MeshAssetHandle.IsValid() && MeshAssetHandle->IsLoadingInProgress()) MeshAssetHandle->CancelHandle();
+	Finish(ERoomGenerationPhase::Cancelled);
+}
+
+float URoomGenerationJob::GetProgress() const
+{
+	if (Phase >= ERoomGenerationPhase::Finished) return Phase == ERoomGenerationPhase::Finished ? 1.0f : 0.0f;
+
+	float Done = static_cast<float>(Phase);
+	if (Phase == ERoomGenerationPhase::SpawningMeshes) Done += static_cast<float>(SpawnCategory) / NumMeshCategories;
+	return Done / static_cast<float>(ERoomGenerationPhase::Finished);
+}
+
+#pragma region FTickableGameObject
+void URoomGenerationJob::Tick(float DeltaTime)
+{
+	if (!Room.IsValid()) { Finish(ERoomGenerationPhase::Failed); return; }
+
+	// At least one step per frame, more while budget is left
+	const double Deadline = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+	while (Step() && FPlatformTime::Seconds() < Deadline) {}
+
+	if (Phase < ERoomGenerationPhase::Finished) OnProgress.Broadcast(this, GetProgress());
+}
+
+bool URoomGenerationJob::IsTickable() const
+{
+	return !IsTemplate() && Phase < ERoomGenerationPhase::Finished;
+}
+
+TStatId URoomGenerationJob::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URoomGenerationJob, STATGROUP_Tickables);
+}
+
+UWorld* URoomGenerationJob::GetTickableGameObjectWorld() const
+{
+	return Room.IsValid() ? Room->GetWorld() : nullptr;
+}
+#pragma endregion
+
+bool URoomGenerationJob::Step()
+{
+	ARoomSpawner* RoomSpawner = Room.Get();
+
+	switch (Phase)
+	{
+	case ERoomGenerationPhase::LoadingStyles:
+	{
+		// Style assets reference the meshes, so they are loaded (and waited for) first
+		if (!StyleAssetHandle.IsValid())
+		{
+			TArray<FSoftObjectPath> StylePaths;
+			URoomGenerationHelpers::GatherRoomStyleAssets(RoomSpawner->RoomData, StylePaths);
+			if (!RequestAssets(MoveTemp(StylePaths), StyleAssetHandle)) return false;
+		}
+		else if (!StyleAssetHandle->HasLoadCompleted()) return false;
+
+		Phase = ERoomGenerationPhase::LoadingMeshes;
+		return true;
+	}
+
+	case ERoomGenerationPhase::LoadingMeshes:
+	{
+		if (!MeshAssetHandle.IsValid())
+		{
+			TArray<FSoftObjectPath> MeshPaths;
+			URoomGenerationHelpers::GatherRoomMeshAssets(RoomSpawner->RoomData, MeshPaths);
+			if (!RequestAssets(MoveTemp(MeshPaths), MeshAssetHandle)) return false;
+		}
+		else if (!MeshAssetHandle->HasLoadCompleted()) return false;
+
+		Phase = ERoomGenerationPhase::Grid;
+		return true;
+	}
+
+	case ERoomGenerationPhase::Grid:
+	{
+		if (!RoomSpawner->ResetRoomForGeneration() || !RoomSpawner->GetRoomGenerator())
+		{ UE_LOG(LogTemp, Error, TEXT("URoomGenerationJob::Step - Failed to prepare %s"), *RoomSpawner->GetName()); Finish(ERoomGenerationPhase::Failed); return false; }
+
+		URoomGenerator* Generator = RoomSpawner->GetRoomGenerator();
+		if (bOverlapSpawning && !RoomSpawner->UsesBuildingPool())
+		{
+			LaunchStreamingStages(Generator);
+			Phase = ERoomGenerationPhase::StreamingStages;
+			return true;
+		}
+
+		Generator->SetPlacementStreaming(false);
+		Phase = ERoomGenerationPhase::Floor;
+		return true;
+	}
+
+	case ERoomGenerationPhase::StreamingStages:
+		return StepStreamedPlacements();
+
+	case ERoomGenerationPhase::Floor:
+	case ERoomGenerationPhase::Walls:
+	case ERoomGenerationPhase::Corners:
+	case ERoomGenerationPhase::Doorways:
+	case ERoomGenerationPhase::Ceiling:
+		if (!RunGeneratorStage(RoomSpawner->GetRoomGenerator(), Phase)) { Finish(ERoomGenerationPhase::Failed); return false; }
+
+		// Stages are consecutive in ERoomGenerationPhase, Ceiling is followed by SpawningMeshes
+		Phase = static_cast<ERoomGenerationPhase>(static_cast<uint8>(Phase) + 1);
+		return true;
+
+	case ERoomGenerationPhase::SpawningMeshes:
+		if (!StepSpawnMeshes()) Phase = ERoomGenerationPhase::SpawningDoorways;
+		return true;
+
+	case ERoomGenerationPhase::SpawningDoorways:
+		RoomSpawner->SpawnDoorwayActors();
+		RoomSpawner->FinishRuntimeGeneration();
+		Finish(ERoomGenerationPhase::Finished);
+		return false;
+
+	default:
+		return false;
+	}
+}
+
+bool URoomGenerationJob::RunGeneratorStage(URoomGenerator* Generator, ERoomGenerationPhase Stage)
+{
+	// Floor and walls are required, the remaining stages are optional for a room (same as URoomGenerator::BuildStageGraph)
+	switch (Stage)
+	{
+	case ERoomGenerationPhase::Floor:
+		if (!Generator->GenerateFloor())
+		{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerationJob::RunGeneratorStage - GenerateFloor failed")); return false; }
+		return true;
+
+	case ERoomGenerationPhase::Walls:
+		if (!Generator->GenerateWalls())
+		{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerationJob::RunGeneratorStage - GenerateWalls failed")); return false; }
+		return true;
+
+	case ERoomGenerationPhase::Corners:
+		if (!Generator->GenerateCorners())
+		{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerationJob::RunGeneratorStage - GenerateCorners failed")); }
+		return true;
+
+	case ERoomGenerationPhase::Doorways:
+		if (!Generator->GenerateDoorways())
+		{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerationJob::RunGeneratorStage - GenerateDoorways failed")); }
+		return true;
+
+	case ERoomGenerationPhase::Ceiling:
+		if (!Generator->GenerateCeiling())
+		{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerationJob::RunGeneratorStage - GenerateCeiling failed")); }
+		return true;
+
+	default:
+		return true;
+	}
+}
+
+void URoomGenerationJob::LaunchStreamingStages(URoomGenerator* Generator)
+{
+	// Compiled caches are built lazily, build them here rather than on the worker (see UBuildingGen::PreloadBatchAssets)
+	const URoomData* RoomData = Room->RoomData;
+	if (UFloorData* FloorStyleData = RoomData->FloorStyleData.Get()) FloorStyleData->GetCompiledFloorTilePool();
+	if (UWallData* WallStyleData = RoomData->WallStyleData.Get()) WallStyleData->GetCompiledWallModuleTable();
+	if (UCeilingData* CeilingStyleData = RoomData->CeilingStyleData.Get()) CeilingStyleData->GetCompiledCeilingTilePool();
+
+	Generator->SetPlacementStreaming(true);
+
+	FRoomStageGraph StageGraph;
+	Generator->BuildStageGraph(StageGraph);
+
+	// The room keeps the generator referenced, the guard holds off GC while the stages write its UPROPERTY arrays
+	StageTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Generator, StageGraph = MoveTemp(StageGraph)]()
+	{
+		FGCScopeGuard GCGuard;
+		return StageGraph.Execute(*Generator);
+	});
+}
+
+bool URoomGenerationJob::StepStreamedPlacements()
+{
+	ARoomSpawner* RoomSpawner = Room.Get();
+	URoomGenerator* Generator = RoomSpawner->GetRoomGenerator();
+
+	// Read before draining: everything published before the worker finished is then drained by this or a later pass
+	const bool bStagesDone = StageTask.IsCompleted();
+
+	TMap<TPair<ERoomMeshCategory, TSoftObjectPtr<UStaticMesh>>, TArray<FTransform>> Chunk;
+	FRoomStreamedPlacement Placement;
+	int32 Dequeued = 0;
+	while (Dequeued < InstancesPerStep && Generator->DequeuePlacement(Placement))
+	{
+		Chunk.FindOrAdd({ Placement.Category, Placement.Mesh }).Add(Placement.Transform);
+		++Dequeued;
+	}
+
+	for (const TPair<TPair<ERoomMeshCategory, TSoftObjectPtr<UStaticMesh>>, TArray<FTransform>>& Batch : Chunk)
+	{
+		RoomSpawner->AddMeshInstances(Batch.Key.Key, Batch.Key.Value, Batch.Value);
+	}
+
+	if (Dequeued > 0) return true;
+
+	// Queue drained but the worker is still deciding, check again next frame
+	if (!bStagesDone) return false;
+
+	Generator->SetPlacementStreaming(false);
+	if (!StageTask.GetResult()) { Finish(ERoomGenerationPhase::Failed); return false; }
+
+	// Meshes are spawned already, only the doorway actors are left
+	Phase = ERoomGenerationPhase::SpawningDoorways;
+	return true;
+}
+
+bool URoomGenerationJob::RequestAssets(TArray<FSoftObjectPath>&& Paths, TSharedPtr<FStreamableHandle>& Handle)
+{
+	if (Paths.Num() == 0) return true;
+
+	Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths));
+	return !Handle.IsValid() || Handle->HasLoadCompleted();
+}
+
+bool URoomGenerationJob::StepSpawnMeshes()
+{
+	ARoomSpawner* RoomSpawner = Room.Get();
+	if (SpawnCategory >= NumMeshCategories) return false;
+	const ERoomMeshCategory Category = static_cast<ERoomMeshCategory>(SpawnCategory);
+
+	// Pool ranges are replaced as a whole, one category per step
+	if (RoomSpawner->UsesBuildingPool())
+	{
+		TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>> Batches;
+		RoomSpawner->GatherMeshBatches(Category, Batches);
+		RoomSpawner->SubmitCategoryBatches(Category, Batches);
+		++SpawnCategory;
+		return SpawnCategory < NumMeshCategories;
+	}
+
+	if (!bCategoryGathered)
+	{
+		TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>> Batches;
+		RoomSpawner->GatherMeshBatches(Category, Batches);
+
+		CategoryBatches.Reset(Batches.Num());
+		for (TPair<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batch : Batches) { CategoryBatches.Emplace(Batch.Key, MoveTemp(Batch.Value)); }
+
+		bCategoryGathered = true;
+		BatchIndex = 0;
+		InstanceIndex = 0;
+	}
+
+	if (CategoryBatches.IsValidIndex(BatchIndex))
+	{
+		const TPair<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batch = CategoryBatches[BatchIndex];
+		const int32 ChunkSize = FMath::Min(InstancesPerStep, Batch.Value.Num() - InstanceIndex);
+
+		const TArray<FTransform> Chunk(Batch.Value.GetData() + InstanceIndex, ChunkSize);
+		RoomSpawner->AddMeshInstances(Category, Batch.Key, Chunk);
+
+		InstanceIndex += ChunkSize;
+		if (InstanceIndex >= Batch.Value.Num()) { ++BatchIndex; InstanceIndex = 0; }
+		if (CategoryBatches.IsValidIndex(BatchIndex)) return true;
+	}
+
+	// Category done, the next step starts the following one
+	CategoryBatches.Reset();
+	bCategoryGathered = false;
+	++SpawnCategory;
+	return SpawnCategory < NumMeshCategories;
+}
+
+void URoomGenerationJob::Finish(ERoomGenerationPhase EndPhase)
+{
+	// Stages can't be interrupted, the worker has to be done before the room or generator go away
+	if (StageTask.IsValid())
+	{
+		StageTask.Wait();
+		StageTask = {};
+		if (Room.IsValid() && Room->GetRoomGenerator()) Room->GetRoomGenerator()->SetPlacementStreaming(false);
+	}
+
+	Phase = EndPhase;
+	CategoryBatches.Empty();
+	OnFinished.Broadcast(this, EndPhase == ERoomGenerationPhase::Finished);
+}
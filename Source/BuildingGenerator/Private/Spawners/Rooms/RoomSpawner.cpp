@@ -2,12 +2,19 @@
 
 #include "Spawners/Rooms/RoomSpawner.h"
 #include "Generators/Rooms/RoomGenerator.h"
+#include "Components/BoxComponent.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/TextRenderComponent.h"
 #include "Data/Generation/RoomGenerationTypes.h"
 #include "Data/Room/DoorData.h" 
+#include "Engine/AssetManager.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StreamableManager.h"
 #include "Generators/Rooms/UniformRoomGenerator.h"
 #include "RoomActors/Doorway.h"
+#include "Spawners/Rooms/RoomGenerationJob.h"
+#include "Spawners/Building/BuildingInstancePool.h"
+#include "Spawners/Building/BuildingSpawner.h"
 #include "Utilities/Generation/RoomGenerationHelpers.h"
 #include "Utilities/Spawners/RoomSpawnerHelpers.h" 
 
@@ -20,6 +27,9 @@ ARoomSpawner::ARoomSpawner()
 	SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
 	RootComponent = SceneRoot;
 
+	// Pooled meshes don't follow the room on their own
+	SceneRoot->TransformUpdated.AddUObject(this, &ARoomSpawner::OnRoomTransformUpdated);
+
 	// Create debug helpers component
 	DebugHelpers = CreateDefaultSubobject<UDebugHelpers>(TEXT("DebugHelpers"));
 
@@ -40,6 +50,444 @@ bool ARoomSpawner::EnsureGeneratorReady()
 	return false;
 }
 
+void ARoomSpawner::Destroyed()
+{
+	if (GenerationJob) GenerationJob->Cancel();
+	ReleasePoolRange(FloorPoolRange);
+	ReleasePoolRange(WallPoolRange);
+	ReleasePoolRange(CornerPoolRange);
+	ReleasePoolRange(CeilingPoolRange);
+	if (OwningBuilding) OwningBuilding->MarkPortalGraphDirty();
+
+	Super::Destroyed();
+}
+
+#pragma region Building Instance Pool
+int32 ARoomSpawner::SubmitMeshBatches(const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, int32& PoolRange, const FString& ComponentNamePrefix,
+	bool bInstanceCollision)
+{
+	UBuildingInstancePool* Pool = OwningBuilding ? OwningBuilding->GetInstancePool() : nullptr;
+
+	// Room left its pool (or moved to another building): drop the old range first
+	if (PoolRange != INDEX_NONE && RegisteredPool.Get() != Pool) ReleasePoolRange(PoolRange);
+
+	// ISM components are attached relatively, so instances are in local space (zero offset)
+	if (!Pool)
+	{
+		const int32 ChangedCount = URoomSpawnerHelpers::SyncMeshInstanceBatches(this, Batches, ComponentMap, ComponentNamePrefix, FVector::ZeroVector);
+
+		// Components created while the room is culled start visible, merged collision proxies replace instance bodies
+		for (const TPair<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& Pair : ComponentMap)
+		{
+			if (!bMeshesVisible) Pair.Value->SetVisibility(false);
+			Pair.Value->SetCollisionEnabled(bInstanceCollision ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+		}
+		return ChangedCount;
+	}
+
+	// Pooled rooms own no components of their own
+	if (ComponentMap.Num() > 0) URoomSpawnerHelpers::ClearISMComponentMap(ComponentMap);
+
+	RegisteredPool = Pool;
+	const int32 AddedCount = Pool->ReplaceInstanceRange(PoolRange, Batches, GetActorTransform(), bInstanceCollision);
+
+	// New ranges start visible, keep them in line with the rest of a culled room
+	if (!bMeshesVisible && PoolRange != INDEX_NONE) Pool->SetInstanceRangeHidden(PoolRange, true);
+	return AddedCount;
+}
+
+void ARoomSpawner::ReleasePoolRange(int32& PoolRange)
+{
+	if (PoolRange == INDEX_NONE) return;
+
+	if (UBuildingInstancePool* Pool = RegisteredPool.Get()) Pool->RemoveInstanceRange(PoolRange);
+	PoolRange = INDEX_NONE;
+}
+
+void ARoomSpawner::OnRoomTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	// Portal openings are stored in world space, so they move with the room
+	if (OwningBuilding) OwningBuilding->MarkPortalGraphDirty();
+
+	UBuildingInstancePool* Pool = RegisteredPool.Get();
+	if (!Pool) return;
+
+	for (const int32 PoolRange : { FloorPoolRange, WallPoolRange, CornerPoolRange, CeilingPoolRange })
+	{
+		if (PoolRange != INDEX_NONE) Pool->SetInstanceRangeTransform(PoolRange, GetActorTransform());
+	}
+}
+#pragma endregion
+
+#pragma region Mesh Categories
+TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ARoomSpawner::GetCategoryComponents(ERoomMeshCategory Category)
+{
+	switch (Category)
+	{
+	case ERoomMeshCategory::Wall:    return WallMeshComponents;
+	case ERoomMeshCategory::Corner:  return CornerMeshComponents;
+	case ERoomMeshCategory::Ceiling: return CeilingMeshComponents;
+	default:                         return FloorMeshComponents;
+	}
+}
+
+int32& ARoomSpawner::GetCategoryPoolRange(ERoomMeshCategory Category)
+{
+	switch (Category)
+	{
+	case ERoomMeshCategory::Wall:    return WallPoolRange;
+	case ERoomMeshCategory::Corner:  return CornerPoolRange;
+	case ERoomMeshCategory::Ceiling: return CeilingPoolRange;
+	default:                         return FloorPoolRange;
+	}
+}
+
+const TCHAR* ARoomSpawner::GetCategoryComponentPrefix(ERoomMeshCategory Category)
+{
+	switch (Category)
+	{
+	case ERoomMeshCategory::Wall:    return TEXT("WallISM_");
+	case ERoomMeshCategory::Corner:  return TEXT("CornerISM_");
+	case ERoomMeshCategory::Ceiling: return TEXT("CeilingISM_");
+	default:                         return TEXT("FloorISM_");
+	}
+}
+
+void ARoomSpawner::GatherMeshBatches(ERoomMeshCategory Category, TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& OutBatches) const
+{
+	if (!RoomGenerator) return;
+
+	switch (Category)
+	{
+	case ERoomMeshCategory::Floor:
+		for (const FPlacedMeshInfo& PlacedMesh : RoomGenerator->GetPlacedFloorMeshes())
+		{
+			const TSoftObjectPtr<UStaticMesh>* MeshAsset = RoomGenerator->FindPlacedMesh(PlacedMesh);
+			if (MeshAsset) OutBatches.FindOrAdd(*MeshAsset).Add(RoomGenerator->GetFloorTileTransform(PlacedMesh));
+		}
+		break;
+
+	case ERoomMeshCategory::Wall:
+		// Every wall layer is batched under its own mesh
+		for (const FPlacedWallInfo& PlacedWall : RoomGenerator->GetPlacedWalls())
+		{
+			const FWallModule* Module = RoomGenerator->FindPlacedWallModule(PlacedWall);
+			if (Module) URoomSpawnerHelpers::AddWallSegmentToBatches(PlacedWall, *Module, OutBatches);
+		}
+		break;
+
+	case ERoomMeshCategory::Corner:
+		for (const FPlacedCornerInfo& PlacedCorner : RoomGenerator->GetPlacedCorners())
+		{
+			OutBatches.FindOrAdd(PlacedCorner.CornerMesh).Add(PlacedCorner.Transform);
+		}
+		break;
+
+	case ERoomMeshCategory::Ceiling:
+		for (const FPlacedCeilingInfo& PlacedMesh : RoomGenerator->GetPlacedCeilingTiles())
+		{
+			const TSoftObjectPtr<UStaticMesh>* MeshAsset = RoomGenerator->FindPlacedMesh(PlacedMesh);
+			if (MeshAsset) OutBatches.FindOrAdd(*MeshAsset).Add(RoomGenerator->GetCeilingTileTransform(PlacedMesh));
+		}
+		break;
+	}
+}
+
+int32 ARoomSpawner::SubmitCategoryBatches(ERoomMeshCategory Category, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches)
+{
+	return SubmitMeshBatches(Batches, GetCategoryComponents(Category), GetCategoryPoolRange(Category),
+		GetCategoryComponentPrefix(Category), HasInstanceCollision(Category));
+}
+
+int32 ARoomSpawner::AddMeshInstances(ERoomMeshCategory Category, const TSoftObjectPtr<UStaticMesh>& MeshAsset, const TArray<FTransform>& Transforms)
+{
+	UInstancedStaticMeshComponent* ISM = URoomSpawnerHelpers::GetOrCreateISMComponent(this, MeshAsset, GetCategoryComponents(Category),
+		GetCategoryComponentPrefix(Category));
+	if (!ISM) return 0;
+
+	if (!bMeshesVisible) ISM->SetVisibility(false);
+	ISM->SetCollisionEnabled(HasInstanceCollision(Category) ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+	return URoomSpawnerHelpers::SpawnMeshInstances(ISM, Transforms, FVector::ZeroVector);
+}
+
+bool ARoomSpawner::UsesBuildingPool() const
+{
+	return OwningBuilding && OwningBuilding->GetInstancePool();
+}
+#pragma endregion
+
+#pragma region Runtime Generation
+URoomGenerationJob* ARoomSpawner::StartTimeSlicedGeneration(float BudgetMs)
+{
+	if (GenerationJob && GenerationJob->IsRunning()) GenerationJob->Cancel();
+
+	GenerationJob = NewObject<URoomGenerationJob>(this);
+	GenerationJob->BudgetMs = BudgetMs;
+	if (!GenerationJob->Start(this))
+	{ UE_LOG(LogTemp, Error, TEXT("ARoomSpawner::StartTimeSlicedGeneration - Job failed to start")); }
+
+	return GenerationJob;
+}
+
+bool ARoomSpawner::ResetRoomForGeneration()
+{
+	for (const ERoomMeshCategory Category : { ERoomMeshCategory::Floor, ERoomMeshCategory::Wall, ERoomMeshCategory::Corner, ERoomMeshCategory::Ceiling })
+	{
+		// Components are kept (the job refills them), re-registering them every regeneration is the costly part
+		for (const TPair<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& Pair : GetCategoryComponents(Category))
+		{
+			if (IsValid(Pair.Value)) Pair.Value->ClearInstances();
+		}
+		ReleasePoolRange(GetCategoryPoolRange(Category));
+	}
+	DestroyDoorwayActors();
+
+	if (RoomGenerator) RoomGenerator->ClearGrid();
+	bIsGenerated = false;
+
+	// A cleared generator is uninitialized, so this re-initializes and creates the grid
+	return EnsureGeneratorReady();
+}
+
+void ARoomSpawner::FinishRuntimeGeneration()
+{
+	RebuildCollisionProxies();
+	bIsGenerated = true;
+	if (OwningBuilding) OwningBuilding->MarkPortalGraphDirty();
+}
+#pragma endregion
+
+#pragma region Doorway Actors
+int32 ARoomSpawner::SpawnDoorwayActors()
+{
+    if (!RoomGenerator) return 0;
+
+    if (!DoorwayActorClass)
+    { DebugHelpers->LogCritical(TEXT("DoorwayActorClass is not set!")); return 0; }
+
+    int32 DoorwaysSpawned = 0;
+    for (const FPlacedDoorwayInfo& PlacedDoor : RoomGenerator->GetPlacedDoorways())
+    {
+        // Validate door data
+        if (!PlacedDoor.DoorData)
+        {
+            DebugHelpers->LogVerbose(TEXT("  Doorway has null DoorData - skipping"));
+            continue;
+        }
+
+        // Calculate world transform (room space → world space)
+        FTransform LocalTransform  = PlacedDoor.FrameTransform;
+
+        // Spawn parameters
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Owner = this;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        // Spawn doorway actor
+        ADoorway* DoorwayActor = GetWorld()->SpawnActor<ADoorway>(
+            DoorwayActorClass,
+            LocalTransform,
+            SpawnParams
+        );
+
+        if (DoorwayActor)
+        {
+        	DoorwayActor->AttachToActor(this, FAttachmentTransformRules:: KeepRelativeTransform);
+        	
+            // Initialize doorway with configuration
+            DoorwayActor->InitializeDoorway(
+                PlacedDoor.DoorData,
+                PlacedDoor.Edge,
+                PlacedDoor.bIsStandardDoorway
+            );
+
+            // Store reference
+            DoorwayActor->SetActorHiddenInGame(!bMeshesVisible);
+            SpawnedDoorwayActors.Add(DoorwayActor);
+            DoorwaysSpawned++;
+
+            FString DoorType = PlacedDoor.bIsStandardDoorway ? TEXT("Standard") : TEXT("Manual");
+            DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %s doorway on edge %s"),
+                *DoorType, *UEnum::GetValueAsString(PlacedDoor.Edge)));
+        }
+        else
+        {
+            DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn doorway on edge %s"),
+                *UEnum::GetValueAsString(PlacedDoor.Edge)));
+        }
+    }
+
+    return DoorwaysSpawned;
+}
+
+void ARoomSpawner::DestroyDoorwayActors()
+{
+	for (ADoorway* DoorwayActor : SpawnedDoorwayActors)
+	{
+		if (IsValid(DoorwayActor))
+		{
+			DoorwayActor->Destroy();
+		}
+	}
+
+	SpawnedDoorwayActors.Empty();
+}
+#pragma endregion
+
+#pragma region Collision Proxies
+void ARoomSpawner::RebuildCollisionProxies()
+{
+	TArray<FBox> Boxes;
+	if (bUseMergedCollision && RoomGenerator) RoomGenerator->BuildCollisionBoxes(CollisionFloorThickness, CollisionWallThickness, Boxes);
+
+	// Existing boxes are reused, only the surplus is destroyed or created
+	while (CollisionBoxComponents.Num() > Boxes.Num())
+	{
+		UBoxComponent* Surplus = CollisionBoxComponents.Pop();
+		if (IsValid(Surplus)) Surplus->DestroyComponent();
+	}
+
+	for (int32 BoxIndex = 0; BoxIndex < Boxes.Num(); ++BoxIndex)
+	{
+		if (!CollisionBoxComponents.IsValidIndex(BoxIndex)) CollisionBoxComponents.Add(nullptr);
+
+		UBoxComponent*& Box = CollisionBoxComponents[BoxIndex];
+		if (!IsValid(Box))
+		{
+			Box = NewObject<UBoxComponent>(this, MakeUniqueObjectName(this, UBoxComponent::StaticClass(), TEXT("CollisionProxy")));
+			Box->RegisterComponent();
+			Box->AttachToComponent(SceneRoot, FAttachmentTransformRules::KeepRelativeTransform);
+			Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		}
+
+		Box->SetRelativeLocation(Boxes[BoxIndex].GetCenter());
+		Box->SetBoxExtent(Boxes[BoxIndex].GetExtent());
+	}
+
+	DebugHelpers->LogVerbose(FString::Printf(TEXT("  Collision proxies: %d merged boxes"), Boxes.Num()));
+}
+#pragma endregion
+
+#pragma region Visibility
+void ARoomSpawner::SetRoomMeshesVisible(bool bVisible)
+{
+	if (bMeshesVisible == bVisible) return;
+	bMeshesVisible = bVisible;
+
+	for (TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>* ComponentMap :
+		{ &FloorMeshComponents, &WallMeshComponents, &CornerMeshComponents, &CeilingMeshComponents })
+	{
+		for (const TPair<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& Pair : *ComponentMap)
+		{
+			if (IsValid(Pair.Value)) Pair.Value->SetVisibility(bVisible);
+		}
+	}
+
+	if (UBuildingInstancePool* Pool = RegisteredPool.Get())
+	{
+		for (const int32 PoolRange : { FloorPoolRange, WallPoolRange, CornerPoolRange, CeilingPoolRange })
+		{
+			if (PoolRange != INDEX_NONE) Pool->SetInstanceRangeHidden(PoolRange, !bVisible);
+		}
+	}
+
+	for (ADoorway* DoorwayActor : SpawnedDoorwayActors)
+	{
+		if (IsValid(DoorwayActor)) DoorwayActor->SetActorHiddenInGame(!bVisible);
+	}
+}
+
+bool ARoomSpawner::ContainsWorldPoint(const FVector& WorldLocation) const
+{
+	if (!RoomGenerator) return false;
+
+	const UWallData* WallData = RoomData ? RoomData->WallStyleData.Get() : nullptr;
+	const float RoomHeight = WallData ? WallData->WallHeight : GetDefault<UWallData>()->WallHeight;
+	const FVector RoomExtent(RoomGenerator->GetGridSize().X * RoomGenerator->GetCellSize(),
+		RoomGenerator->GetGridSize().Y * RoomGenerator->GetCellSize(), RoomHeight);
+
+	const FVector Local = GetActorTransform().InverseTransformPosition(WorldLocation);
+	return FBox(FVector::ZeroVector, RoomExtent).IsInsideOrOn(Local);
+}
+#pragma endregion
+
+#pragma region Asset Streaming
+bool ARoomSpawner::EnsureRoomAssetsLoaded(void (ARoomSpawner::*Continuation)())
+{
+	// Missing RoomData is reported by EnsureGeneratorReady
+	if (!RoomData) return true;
+
+	// Request just completed, unresolved references were already reported by OnRoomAssetsStreamed
+	if (bRunningAssetContinuations) return true;
+
+	// Request already in flight, run after it
+	if (PendingAssetContinuations.Num() > 0)
+	{
+		PendingAssetContinuations.AddUnique(Continuation);
+		return false;
+	}
+
+	TArray<FSoftObjectPath> StylePaths;
+	URoomGenerationHelpers::GatherRoomStyleAssets(RoomData, StylePaths);
+	if (StylePaths.Num() == 0)
+	{
+		TArray<FSoftObjectPath> MeshPaths;
+		URoomGenerationHelpers::GatherRoomMeshAssets(RoomData, MeshPaths);
+		if (MeshPaths.Num() == 0) return true;
+	}
+
+	PendingAssetContinuations.Add(Continuation);
+	DebugHelpers->LogImportant(TEXT("Streaming room assets, generation continues when loading completes..."));
+
+	FStreamableManager& Streamable = UAssetManager::GetStreamableManager();
+	if (StylePaths.Num() > 0)
+	{
+		StyleAssetHandle = Streamable.RequestAsyncLoad(MoveTemp(StylePaths),
+			FStreamableDelegate::CreateUObject(this, &ARoomSpawner::StreamRoomMeshAssets));
+	}
+	else
+	{
+		StreamRoomMeshAssets();
+	}
+	return false;
+}
+
+void ARoomSpawner::StreamRoomMeshAssets()
+{
+	TArray<FSoftObjectPath> MeshPaths;
+	URoomGenerationHelpers::GatherRoomMeshAssets(RoomData, MeshPaths);
+	if (MeshPaths.Num() == 0) { OnRoomAssetsStreamed(); return; }
+
+	DebugHelpers->LogVerbose(FString::Printf(TEXT("Requesting %d room meshes"), MeshPaths.Num()));
+	MeshAssetHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(MeshPaths),
+		FStreamableDelegate::CreateUObject(this, &ARoomSpawner::OnRoomAssetsStreamed));
+}
+
+void ARoomSpawner::OnRoomAssetsStreamed()
+{
+	TArray<void (ARoomSpawner::*)()> Continuations = MoveTemp(PendingAssetContinuations);
+	PendingAssetContinuations.Reset();
+
+	// Anything still unloaded could not be resolved (missing or invalid soft reference)
+	TArray<FSoftObjectPath> FailedPaths;
+	URoomGenerationHelpers::GatherRoomStyleAssets(RoomData, FailedPaths);
+	URoomGenerationHelpers::GatherRoomMeshAssets(RoomData, FailedPaths);
+	for (const FSoftObjectPath& FailedPath : FailedPaths)
+	{
+		DebugHelpers->LogCritical(FString::Printf(TEXT("Failed to stream room asset %s"), *FailedPath.ToString()));
+	}
+
+	DebugHelpers->LogImportant(FailedPaths.Num() > 0
+		? FString::Printf(TEXT("Room assets streamed (%d failed)"), FailedPaths.Num())
+		: FString(TEXT("Room assets streamed")));
+
+	// Continuations generate with whatever resolved instead of re-requesting the failed paths
+	TGuardValue<bool> ContinuationGuard(bRunningAssetContinuations, true);
+	for (void (ARoomSpawner::*Continuation)() : Continuations) (this->*Continuation)();
+}
+#pragma endregion
+
 #if WITH_EDITOR
 #pragma region In Editor Functions
 
@@ -113,6 +561,7 @@ void ARoomSpawner::ClearRoomGrid()
 	// Clear the grid
 	RoomGenerator->ClearGrid();
 	bIsGenerated = false;
+	if (OwningBuilding) OwningBuilding->MarkPortalGraphDirty();
 	
 	// Clear coordinate text components (DebugHelpers manages them)
 	DebugHelpers->ClearCoordinateTextComponents();
@@ -126,6 +575,9 @@ void ARoomSpawner::ClearRoomGrid()
 
 void ARoomSpawner::GenerateFloorMeshes()
 {
+	// Meshes are streamed first, this function runs again once they are resident
+	if (!EnsureRoomAssetsLoaded(&ARoomSpawner::GenerateFloorMeshes)) return;
+
 	DebugHelpers->LogSectionHeader(TEXT("GENERATE FLOOR MESHES"));
 	
 	if (!EnsureGeneratorReady())
@@ -135,8 +587,9 @@ void ARoomSpawner::GenerateFloorMeshes()
 		return;
 	}
 	
-	// CLEANUP: Clear existing floor meshes
-	ClearFloorMeshes();
+	// CLEANUP: Reset the floor layout, ISM components are kept and synced below
+	RoomGenerator->ClearPlacedFloorMeshes();
+	RoomGenerator->ResetGridCellStates();
 	
 	// Generate Floor Layout
 	DebugHelpers->LogImportant(TEXT("Generating floor layout..."));
@@ -151,47 +604,17 @@ void ARoomSpawner::GenerateFloorMeshes()
 	const TArray<FPlacedMeshInfo>& PlacedMeshes = RoomGenerator->GetPlacedFloorMeshes();
 	DebugHelpers->LogImportant(FString::Printf(TEXT("Spawning %d floor mesh instances... "), PlacedMeshes.Num()));
 	
-	// ✅ REMOVED: No need to get RoomOrigin anymore
-	// ISM components are attached relatively, so instances are in local space
-	
-	// SPAWNING: Create ISM components and add instances
-	for (const FPlacedMeshInfo& PlacedMesh : PlacedMeshes)
-	{
-		// Get or create ISM component for this mesh
-		UInstancedStaticMeshComponent* ISM = URoomSpawnerHelpers::GetOrCreateISMComponent(
-			this,
-			PlacedMesh.MeshInfo.MeshAsset,
-			FloorMeshComponents,
-			TEXT("FloorISM_"),
-			true
-		);
+	// SPAWNING: Group placements by mesh, then diff each ISM component (or the building pool range) against its new transforms
+	TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>> FloorBatches;
+	GatherMeshBatches(ERoomMeshCategory::Floor, FloorBatches);
 
-		if (ISM)
-		{
-			// ✅ CHANGED: Pass zero offset - instances are in local space relative to ISM component
-			int32 InstanceIndex = URoomSpawnerHelpers::SpawnMeshInstance(
-				ISM, 
-				PlacedMesh.LocalTransform,  // Actually local transform (misnamed)
-				FVector::ZeroVector         // No offset needed
-			);
-
-			if (InstanceIndex >= 0)
-			{
-				DebugHelpers->LogVerbose(FString::Printf(
-					TEXT("  Spawned floor mesh at grid position (%d, %d), instance %d"),
-					PlacedMesh.GridPosition. X, PlacedMesh. GridPosition.Y, InstanceIndex));
-			}
-			else
-			{
-				DebugHelpers->LogVerbose(FString::Printf(
-					TEXT("  Failed to spawn floor mesh at grid position (%d, %d)"),
-					PlacedMesh.GridPosition.X, PlacedMesh.GridPosition.Y));
-			}
-		}
-	}
+	const int32 FloorChanges = SubmitCategoryBatches(ERoomMeshCategory::Floor, FloorBatches);
+	DebugHelpers->LogVerbose(FString::Printf(TEXT("  Synced floor instances: %d slots changed across %d meshes"), FloorChanges, FloorBatches.Num()));
 	
+	RebuildCollisionProxies();
+
 	DebugHelpers->LogImportant(FString::Printf(TEXT("Floor meshes generated:  %d instances across %d unique meshes"),
-		PlacedMeshes.Num(), FloorMeshComponents.Num()));
+		PlacedMeshes.Num(), FloorBatches.Num()));
 	DebugHelpers->LogSectionHeader(TEXT("GENERATE FLOOR MESHES"));
 }
 
@@ -199,6 +622,7 @@ void ARoomSpawner::ClearFloorMeshes()
 {
 	// Clear all floor ISM components
 	URoomSpawnerHelpers:: ClearISMComponentMap(FloorMeshComponents);
+	ReleasePoolRange(FloorPoolRange);
 
 	// Clear generator data AND reset grid state
 	if (RoomGenerator)
@@ -209,6 +633,7 @@ void ARoomSpawner::ClearFloorMeshes()
 		// Reset grid cells (ECT_FloorMesh → back to target type)
 		RoomGenerator->ResetGridCellStates();
 	}
+	RebuildCollisionProxies();
 	DebugHelpers->LogImportant(TEXT("Floor meshes cleared"));
 }
 #pragma endregion
@@ -216,6 +641,9 @@ void ARoomSpawner::ClearFloorMeshes()
 #pragma region Wall Generation
 void ARoomSpawner::GenerateWallMeshes()
 {
+	// Meshes are streamed first, this function runs again once they are resident
+	if (!EnsureRoomAssetsLoaded(&ARoomSpawner::GenerateWallMeshes)) return;
+
 	DebugHelpers->LogSectionHeader(TEXT("GENERATE WALL MESHES"));
 
 	if (!EnsureGeneratorReady())
@@ -225,8 +653,8 @@ void ARoomSpawner::GenerateWallMeshes()
 		return;
 	}
 	
-	// Clear existing wall meshes
-	ClearWallMeshes();
+	// Reset the wall layout, ISM components are kept and synced below
+	RoomGenerator->ClearPlacedWalls();
 	
 	// Generate wall layout (logic only)
 	DebugHelpers->LogImportant(TEXT("Generating wall layout..."));
@@ -241,20 +669,26 @@ void ARoomSpawner::GenerateWallMeshes()
 	const TArray<FPlacedWallInfo>& PlacedWalls = RoomGenerator->GetPlacedWalls();
 	DebugHelpers->LogImportant(FString::Printf(TEXT("Spawning %d wall segments...  "), PlacedWalls.Num()));
 	
-	// Spawn wall segments
-	for (const FPlacedWallInfo& PlacedWall : PlacedWalls) 
-	{ 
-		SpawnWallSegment(PlacedWall, FVector:: ZeroVector);  // ✅ Pass zero offset
-	}
+	// Group every wall layer by mesh, then diff each ISM component against its new transforms
+	TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>> WallBatches;
+	GatherMeshBatches(ERoomMeshCategory::Wall, WallBatches);
+
+	const int32 WallChanges = SubmitCategoryBatches(ERoomMeshCategory::Wall, WallBatches);
+	DebugHelpers->LogVerbose(FString::Printf(TEXT("  Synced wall instances: %d slots changed across %d meshes"), WallChanges, WallBatches.Num()));
 	
+	RebuildCollisionProxies();
+
 	DebugHelpers->LogImportant(TEXT("Wall meshes generated successfully!"));
 	DebugHelpers->LogSectionHeader(TEXT("GENERATE WALL MESHES"));
 }
 
 void ARoomSpawner::SpawnWallSegment(const FPlacedWallInfo& PlacedWall, const FVector& RoomOrigin)
 {
+	const FWallModule* Module = RoomGenerator ? RoomGenerator->FindPlacedWallModule(PlacedWall) : nullptr;
+	if (!Module) return;
+
 	// Delegate to helper
-	URoomSpawnerHelpers::SpawnWallSegment(this, PlacedWall,WallMeshComponents, 
+	URoomSpawnerHelpers::SpawnWallSegment(this, PlacedWall, *Module, WallMeshComponents, 
 	RoomOrigin, TEXT("WallISM_"), DebugHelpers);
 }
 
@@ -262,9 +696,11 @@ void ARoomSpawner::ClearWallMeshes()
 {
 	// Clear all wall ISM components
 	URoomSpawnerHelpers::ClearISMComponentMap(WallMeshComponents);
+	ReleasePoolRange(WallPoolRange);
 
 	// Clear generator data
 	if (RoomGenerator) { RoomGenerator->ClearPlacedWalls();	}
+	RebuildCollisionProxies();
 	DebugHelpers->LogImportant(TEXT("Wall meshes cleared"));
 }
 #pragma endregion
@@ -272,6 +708,9 @@ void ARoomSpawner::ClearWallMeshes()
 #pragma region Corner Generation
 void ARoomSpawner::GenerateCornerMeshes()
 {
+	// Meshes are streamed first, this function runs again once they are resident
+	if (!EnsureRoomAssetsLoaded(&ARoomSpawner::GenerateCornerMeshes)) return;
+
 	 DebugHelpers->LogSectionHeader(TEXT("GENERATE CORNER MESHES"));
 
     if (!EnsureGeneratorReady())
@@ -281,8 +720,8 @@ void ARoomSpawner::GenerateCornerMeshes()
         return;
     }
 
-    // Clear existing corners
-    ClearCornerMeshes();
+    // Reset the corner layout, ISM components are kept and synced below
+    RoomGenerator->ClearPlacedCorners();
 
     // Generate corner layout (logic only)
     DebugHelpers->LogImportant(TEXT("Generating corner layout..."));
@@ -305,38 +744,12 @@ void ARoomSpawner::GenerateCornerMeshes()
 
     DebugHelpers->LogImportant(FString::Printf(TEXT("Spawning %d corner pieces..."), PlacedCorners.Num()));
 
-    // Spawn corner meshes
-    for (const FPlacedCornerInfo& PlacedCorner : PlacedCorners)
-    {
-        // Get or create ISM component for corner mesh
-        UInstancedStaticMeshComponent* ISM = URoomSpawnerHelpers::GetOrCreateISMComponent(
-            this,
-            PlacedCorner. CornerMesh,
-            CornerMeshComponents,
-            TEXT("CornerISM_"),
-            true
-        );
-
-        if (ISM)
-        {
-            int32 InstanceIndex = URoomSpawnerHelpers::SpawnMeshInstance(
-                ISM,
-                PlacedCorner.Transform,
-                FVector::ZeroVector
-            );
+    // Group corners by mesh, then diff each ISM component against its new transforms
+    TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>> CornerBatches;
+    GatherMeshBatches(ERoomMeshCategory::Corner, CornerBatches);
 
-            if (InstanceIndex >= 0)
-            {
-                DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %s corner (instance %d)"),
-                    *UEnum::GetValueAsString(PlacedCorner.Corner), InstanceIndex));
-            }
-            else
-            {
-                DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn %s corner"),
-                    *UEnum::GetValueAsString(PlacedCorner. Corner)));
-            }
-        }
-    }
+    const int32 CornerChanges = SubmitCategoryBatches(ERoomMeshCategory::Corner, CornerBatches);
+    DebugHelpers->LogVerbose(FString::Printf(TEXT("  Synced corner instances: %d slots changed"), CornerChanges));
 
     DebugHelpers->LogImportant(TEXT("Corner meshes generated successfully!"));
     DebugHelpers->LogSectionHeader(TEXT("GENERATE CORNER MESHES"));
@@ -346,6 +759,7 @@ void ARoomSpawner::ClearCornerMeshes()
 {
 	// Clear all corner ISM components
 	URoomSpawnerHelpers::ClearISMComponentMap(CornerMeshComponents);
+	ReleasePoolRange(CornerPoolRange);
 
 	// Clear generator data
 	if (RoomGenerator)
@@ -360,6 +774,9 @@ void ARoomSpawner::ClearCornerMeshes()
 #pragma region Doorway Generation
 void ARoomSpawner::GenerateDoorwayMeshes()
 {
+    // Meshes are streamed first, this function runs again once they are resident
+    if (!EnsureRoomAssetsLoaded(&ARoomSpawner::GenerateDoorwayMeshes)) return;
+
     DebugHelpers->LogSectionHeader(TEXT("GENERATE DOORWAY MESHES"));
 
     if (! EnsureGeneratorReady())
@@ -402,62 +819,11 @@ void ARoomSpawner::GenerateDoorwayMeshes()
         return;
     }
 
-    int32 DoorwaysSpawned = 0;
-    int32 DoorwaysSkipped = 0;
-	
-	
-
-    for (const FPlacedDoorwayInfo& PlacedDoor : FinalDoorways)
-    {
-        // Validate door data
-        if (!PlacedDoor.DoorData)
-        {
-            DebugHelpers->LogVerbose(TEXT("  Doorway has null DoorData - skipping"));
-            DoorwaysSkipped++;
-            continue;
-        }
-
-        // Calculate world transform (room space → world space)
-        FTransform LocalTransform  = PlacedDoor.FrameTransform;
-
-        // Spawn parameters
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.Owner = this;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    const int32 DoorwaysSpawned = SpawnDoorwayActors();
+    const int32 DoorwaysSkipped = FinalDoorways.Num() - DoorwaysSpawned;
 
-        // Spawn doorway actor
-        ADoorway* DoorwayActor = GetWorld()->SpawnActor<ADoorway>(
-            DoorwayActorClass,
-            LocalTransform,
-            SpawnParams
-        );
-
-        if (DoorwayActor)
-        {
-        	DoorwayActor->AttachToActor(this, FAttachmentTransformRules:: KeepRelativeTransform);
-        	
-            // Initialize doorway with configuration
-            DoorwayActor->InitializeDoorway(
-                PlacedDoor.DoorData,
-                PlacedDoor.Edge,
-                PlacedDoor.bIsStandardDoorway
-            );
-
-            // Store reference
-            SpawnedDoorwayActors.Add(DoorwayActor);
-            DoorwaysSpawned++;
-
-            FString DoorType = PlacedDoor.bIsStandardDoorway ? TEXT("Standard") : TEXT("Manual");
-            DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %s doorway on edge %s"),
-                *DoorType, *UEnum::GetValueAsString(PlacedDoor.Edge)));
-        }
-        else
-        {
-            DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn doorway on edge %s"),
-                *UEnum::GetValueAsString(PlacedDoor.Edge)));
-            DoorwaysSkipped++;
-        }
-    }
+    // Doorways are the building's portals
+    if (OwningBuilding) OwningBuilding->MarkPortalGraphDirty();
 
     DebugHelpers->LogImportant(FString::Printf(TEXT("Doorway spawning complete:  %d actors spawned, %d skipped"),
         DoorwaysSpawned, DoorwaysSkipped));
@@ -467,16 +833,7 @@ void ARoomSpawner::GenerateDoorwayMeshes()
 void ARoomSpawner::ClearDoorwayMeshes()
 {
 	// ✅ CHANGED:  Destroy spawned doorway actors instead of clearing ISM components
-    
-	for (ADoorway* DoorwayActor : SpawnedDoorwayActors)
-	{
-		if (IsValid(DoorwayActor))
-		{
-			DoorwayActor->Destroy();
-		}
-	}
-
-	SpawnedDoorwayActors.Empty();
+	DestroyDoorwayActors();
 	
 	// Layout is cached and persists until ClearRoomGrid()
 	// Transforms will be recalculated with current offsets on next spawn
@@ -488,6 +845,9 @@ void ARoomSpawner::ClearDoorwayMeshes()
 
 void ARoomSpawner::GenerateCeilingMeshes()
 {
+	// Meshes are streamed first, this function runs again once they are resident
+	if (!EnsureRoomAssetsLoaded(&ARoomSpawner::GenerateCeilingMeshes)) return;
+
 	DebugHelpers->LogSectionHeader(TEXT("GENERATE CEILING MESHES"));
 	
 	if (!EnsureGeneratorReady())
@@ -497,8 +857,8 @@ void ARoomSpawner::GenerateCeilingMeshes()
 		return;
 	}
 	
-	// CLEANUP: Clear existing ceiling meshes
-	ClearCeilingMeshes();
+	// CLEANUP: Reset the ceiling layout, ISM components are kept and synced below
+	RoomGenerator->ClearPlacedCeiling();
 	
 	// Generate Ceiling Layout
 	DebugHelpers->LogImportant(TEXT("Generating ceiling layout... "));
@@ -513,32 +873,17 @@ void ARoomSpawner::GenerateCeilingMeshes()
 	const TArray<FPlacedCeilingInfo>& PlacedMeshes = RoomGenerator->GetPlacedCeilingTiles();
 	DebugHelpers->LogImportant(FString::Printf(TEXT("Spawning %d ceiling mesh instances... "), PlacedMeshes.Num()));
 	
-	// SPAWNING: Create ISM components and add instances
-	for (const FPlacedCeilingInfo& PlacedMesh : PlacedMeshes)
-	{
-		// Get or create ISM component for this mesh
-		UInstancedStaticMeshComponent* ISM = URoomSpawnerHelpers::GetOrCreateISMComponent(this,
-		PlacedMesh.MeshInfo.MeshAsset, CeilingMeshComponents, TEXT("CeilingISM_"), true);
+	// SPAWNING: Group placements by mesh, then diff each ISM component against its new transforms
+	TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>> CeilingBatches;
+	GatherMeshBatches(ERoomMeshCategory::Ceiling, CeilingBatches);
 
-		if (ISM)
-		{
-			int32 InstanceIndex = URoomSpawnerHelpers:: SpawnMeshInstance(ISM, PlacedMesh.LocalTransform, FVector::ZeroVector);
-
-			if (InstanceIndex >= 0)
-			{
-				DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned ceiling mesh at grid position (%d, %d), instance %d"),
-				PlacedMesh.GridCoordinate.X, PlacedMesh.GridCoordinate. Y, InstanceIndex));
-			}
-			else
-			{
-				DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn ceiling mesh at grid position (%d, %d)"),
-				PlacedMesh.GridCoordinate. X, PlacedMesh. GridCoordinate.Y));
-			}
-		}
-	}
+	const int32 CeilingChanges = SubmitCategoryBatches(ERoomMeshCategory::Ceiling, CeilingBatches);
+	DebugHelpers->LogVerbose(FString::Printf(TEXT("  Synced ceiling instances: %d slots changed across %d meshes"), CeilingChanges, CeilingBatches.Num()));
 	
+	RebuildCollisionProxies();
+
 	DebugHelpers->LogImportant(FString::Printf(TEXT("Ceiling meshes generated:  %d instances across %d unique meshes"),
-	PlacedMeshes.Num(), CeilingMeshComponents.Num()));
+	PlacedMeshes.Num(), CeilingBatches.Num()));
 	DebugHelpers->LogSectionHeader(TEXT("GENERATE CEILING MESHES"));
 }
 
@@ -546,6 +891,7 @@ void ARoomSpawner::ClearCeilingMeshes()
 {
 	// Clear all ceiling ISM components
 	URoomSpawnerHelpers::ClearISMComponentMap(CeilingMeshComponents);
+	ReleasePoolRange(CeilingPoolRange);
 
 	// Clear generator data
 	if (RoomGenerator)
@@ -553,6 +899,7 @@ void ARoomSpawner::ClearCeilingMeshes()
 		// Clear placed mesh array
 		RoomGenerator->ClearPlacedCeiling();
 	}
+	RebuildCollisionProxies();
 	
 	DebugHelpers->LogImportant(TEXT("Ceiling meshes cleared"));
 }
@@ -736,7 +1083,7 @@ void ARoomSpawner::UpdateVisualization()
 	FVector RoomOrigin = GetActorLocation();
 	FIntPoint GridSize = RoomGenerator->GetGridSize();
 	float CellSize = RoomGenerator->GetCellSize();
-	const TArray<EGridCellType>& GridState = RoomGenerator->GetGridState();
+	const TArray<EGridCellType> GridState = RoomGenerator->GetGridState();
 	DebugHelpers->DrawGrid(GridSize, GridState, CellSize, RoomOrigin);
 
 	// Draw forced empty regions (if any)
@@ -29,7 +29,7 @@ bool AUniformRoomSpawner::EnsureGeneratorReady()
 	{
 		DebugHelpers->LogVerbose(TEXT("Initializing UniformRoomGenerator..."));
 
-		if (!RoomGenerator->Initialize(RoomData, RoomGridSize))
+		if (!RoomGenerator->Initialize(RoomData, RoomGridSize, RoomSeed))
 		{ DebugHelpers->LogCritical(TEXT("Failed to initialize UniformRoomGenerator!")); return false; }
 
 		DebugHelpers->LogVerbose(TEXT("Creating grid cells..."));
@@ -3,32 +3,48 @@
 #include "Utilities/Generation/RoomGenerationHelpers.h"
 
 #include "Data/Generation/RoomGenerationTypes.h"
+#include "Data/Room/CeilingData.h"
+#include "Data/Room/DoorData.h"
+#include "Data/Room/FloorData.h"
+#include "Data/Room/RoomData.h"
+#include "Data/Room/WallData.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshSocket.h"
 
 #pragma region Grid & Cell Operations
 TArray<FIntPoint> URoomGenerationHelpers::GetEdgeCellIndices(EWallEdge Edge, FIntPoint GridSize)
 {
+	const FEdgeCellView View = GetEdgeCellView(Edge, GridSize);
+
 	TArray<FIntPoint> Cells;
+	Cells.Reserve(View.Num());
+	for (int32 CellIndex = 0; CellIndex < View.Num(); ++CellIndex) Cells.Add(View[CellIndex]);
+	return Cells;
+}
+
+FEdgeCellView URoomGenerationHelpers::GetEdgeCellView(EWallEdge Edge, FIntPoint GridSize)
+{
+	FEdgeCellView View;
 	switch (Edge)
 	{
-	case EWallEdge::North:   // North = +X direction, X = GridSize (beyond max)
-		for (int32 Y = 0; Y < GridSize.Y; ++Y) Cells.Add(FIntPoint(GridSize.X, Y)); break;
-        
-	case EWallEdge:: South:  // South = -X direction, X = -1 (before min)
-		for (int32 Y = 0; Y < GridSize.Y; ++Y) Cells.Add(FIntPoint(-1, Y)); break;
-        
+	case EWallEdge::North:  // North = +X direction, X = GridSize (beyond max)
+		View.Origin = FIntPoint(GridSize.X, 0); View.Step = FIntPoint(0, 1); View.Length = GridSize.Y; break;
+
+	case EWallEdge::South:  // South = -X direction, X = -1 (before min)
+		View.Origin = FIntPoint(-1, 0); View.Step = FIntPoint(0, 1); View.Length = GridSize.Y; break;
+
 	case EWallEdge::East:   // East = +Y direction, Y = GridSize (beyond max)
-		for (int32 X = 0; X < GridSize.X; ++X) Cells.Add(FIntPoint(X, GridSize.Y)); break;
-        
-	case EWallEdge:: West:   // West = -Y direction, Y = -1 (before min)
-		for (int32 X = 0; X < GridSize.X; ++X) Cells.Add(FIntPoint(X, -1)); break;
-            
-	default: 
+		View.Origin = FIntPoint(0, GridSize.Y); View.Step = FIntPoint(1, 0); View.Length = GridSize.X; break;
+
+	case EWallEdge::West:   // West = -Y direction, Y = -1 (before min)
+		View.Origin = FIntPoint(0, -1); View.Step = FIntPoint(1, 0); View.Length = GridSize.X; break;
+
+	default:
 		break;
 	}
-    
-	return Cells;
+
+	View.Length = FMath::Max(View.Length, 0);
+	return View;
 }
 
 bool URoomGenerationHelpers::IsValidGridCoordinate(FIntPoint Coord, FIntPoint GridSize)
@@ -134,6 +150,34 @@ FIntPoint URoomGenerationHelpers::GetRotatedFootprint(FIntPoint OriginalFootprin
 	return OriginalFootprint;
 }
 
+FIntPoint URoomGenerationHelpers::CalculateMeshFootprint(const FMeshPlacementInfo& MeshInfo)
+{
+	// If footprint is explicitly defined, use it
+	if (MeshInfo.GridFootprint.X > 0 && MeshInfo. GridFootprint.Y > 0) return MeshInfo.GridFootprint;
+
+	// Otherwise, calculate from mesh bounds
+	// TODO: Load mesh and calculate actual bounds (default 1x1 for now)
+	return FIntPoint(1, 1);
+}
+
+void URoomGenerationHelpers::CompileTilePool(const TArray<FMeshPlacementInfo>& TilePool, FKernelTilePool& OutPool)
+{
+	TArray<FKernelTileDesc> Descs;
+	Descs.Reserve(TilePool.Num());
+	for (int32 TileIndex = 0; TileIndex < TilePool.Num(); ++TileIndex)
+	{
+		const FMeshPlacementInfo& MeshInfo = TilePool[TileIndex];
+
+		FKernelTileDesc& Desc = Descs.AddDefaulted_GetRef();
+		Desc.Footprint = CalculateMeshFootprint(MeshInfo);
+		Desc.Weight = MeshInfo.PlacementWeight;
+		Desc.RotationMask = FRoomGenerationKernel::MakeRotationMask(MeshInfo.AllowedRotations);
+		Desc.MeshId = TileIndex;
+	}
+
+	OutPool.Build(MoveTemp(Descs));
+}
+
 bool URoomGenerationHelpers::DoesRotationSwapDimensions(int32 RotationDegrees)
 {
 	RotationDegrees = RotationDegrees % 360;
@@ -234,6 +278,29 @@ int32 WidthInCells,	FIntPoint GridSize, float CellSize)
     
 	return Position;
 }
+
+void URoomGenerationHelpers::CalculateDoorwayOpening(EWallEdge Edge, int32 StartCell, int32 WidthInCells, FIntPoint GridSize,
+	float CellSize, FVector& OutStart, FVector& OutEnd)
+{
+	// Zero-width doorways sit exactly on the cell boundary
+	OutStart = CalculateDoorwayPosition(Edge, StartCell, 0, GridSize, CellSize);
+	OutEnd = CalculateDoorwayPosition(Edge, StartCell + WidthInCells, 0, GridSize, CellSize);
+}
+
+void URoomGenerationHelpers::CompileWallModuleTable(const TArray<FWallModule>& Modules, FKernelWallModuleTable& OutTable)
+{
+	TArray<FKernelWallModuleDesc> Descs;
+	Descs.Reserve(Modules.Num());
+	for (int32 ModuleIndex = 0; ModuleIndex < Modules.Num(); ++ModuleIndex)
+	{
+		FKernelWallModuleDesc& Desc = Descs.AddDefaulted_GetRef();
+		Desc.Footprint = Modules[ModuleIndex].Y_AxisFootprint;
+		Desc.Weight = Modules[ModuleIndex].PlacementWeight;
+		Desc.ModuleId = ModuleIndex;
+	}
+
+	OutTable.Build(MoveTemp(Descs));
+}
 #pragma endregion
 
 #pragma region Mesh Operations
@@ -247,9 +314,10 @@ const FString& ContextName, bool bLogWarning)
 		return nullptr;
 	}
 
-	UStaticMesh* Mesh = MeshAsset.LoadSynchronous();
+	// Callers run on worker threads too, so a mesh that wasn't streamed beforehand is an error, not a load
+	UStaticMesh* Mesh = MeshAsset.Get();
 	if (!Mesh && bLogWarning)
-	{ UE_LOG(LogTemp, Warning, TEXT("LoadAndValidateMesh: Failed to load mesh for context '%s'"), *ContextName); }
+	{ UE_LOG(LogTemp, Warning, TEXT("LoadAndValidateMesh: Mesh for context '%s' is not loaded"), *ContextName); }
 	return Mesh;
 }
 
@@ -267,6 +335,108 @@ int32 Rotation,	float ZOffset)
 	return FTransform(MeshRotation, LocalPos, FVector:: OneVector);
 	
 }
+
+FTransform URoomGenerationHelpers::CalculateCeilingTransform(FIntPoint GridPosition, FIntPoint TileSize, float CellSize,
+int32 Rotation, const FRotator& CeilingRotation, float CeilingHeight)
+{
+	// Calculate tile position (centered on footprint)
+	FVector TilePosition = FVector((GridPosition.X + TileSize.X / 2.0f) * CellSize, (GridPosition.Y + TileSize.Y / 2.0f) * CellSize,
+		CeilingHeight);
+
+	// Create rotation (base ceiling rotation + tile rotation)
+	FRotator FinalRotation = CeilingRotation;
+	FinalRotation.Yaw += Rotation;
+
+	// Normalize quaternion to avoid floating point errors
+	FQuat NormalizedRotation = FinalRotation.Quaternion();
+	NormalizedRotation.Normalize();
+
+	return FTransform(NormalizedRotation, TilePosition, FVector(1.0f));
+}
+#pragma endregion
+
+#pragma region Asset Preloading
+namespace
+{
+	template<typename T>
+	void AddUnloadedPath(const TSoftObjectPtr<T>& Asset, TArray<FSoftObjectPath>& OutPaths)
+	{
+		if (!Asset.IsNull() && !Asset.Get()) OutPaths.AddUnique(Asset.ToSoftObjectPath());
+	}
+
+	void AddWallModulePaths(const FWallModule& Module, TArray<FSoftObjectPath>& OutPaths)
+	{
+		AddUnloadedPath(Module.BaseMesh, OutPaths);
+		AddUnloadedPath(Module.MiddleMesh1, OutPaths);
+		AddUnloadedPath(Module.MiddleMesh2, OutPaths);
+		AddUnloadedPath(Module.TopMesh, OutPaths);
+	}
+
+	void AddDoorDataPaths(const UDoorData* DoorData, TArray<FSoftObjectPath>& OutPaths)
+	{
+		if (!DoorData) return;
+
+		AddUnloadedPath(DoorData->FrameSideMesh, OutPaths);
+		AddUnloadedPath(DoorData->LeftSideMesh, OutPaths);
+		AddUnloadedPath(DoorData->RightSideMesh, OutPaths);
+		AddUnloadedPath(DoorData->CornerMesh, OutPaths);
+		for (const FWallModule& Module : DoorData->LeftSideModules) AddWallModulePaths(Module, OutPaths);
+		for (const FWallModule& Module : DoorData->RightSideModules) AddWallModulePaths(Module, OutPaths);
+	}
+}
+
+void URoomGenerationHelpers::GatherRoomStyleAssets(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths)
+{
+	if (!RoomData) return;
+
+	AddUnloadedPath(RoomData->FloorStyleData, OutPaths);
+	AddUnloadedPath(RoomData->WallStyleData, OutPaths);
+	AddUnloadedPath(RoomData->DoorStyleData, OutPaths);
+	AddUnloadedPath(RoomData->CeilingStyleData, OutPaths);
+}
+
+void URoomGenerationHelpers::GatherDoorMeshAssets(const UDoorData* DoorData, TArray<FSoftObjectPath>& OutPaths)
+{
+	AddDoorDataPaths(DoorData, OutPaths);
+}
+
+void URoomGenerationHelpers::GatherRoomMeshAssets(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths)
+{
+	if (!RoomData) return;
+
+	// Floor
+	if (const UFloorData* FloorData = RoomData->FloorStyleData.Get())
+	{
+		for (const FMeshPlacementInfo& Tile : FloorData->FloorTilePool) AddUnloadedPath(Tile.MeshAsset, OutPaths);
+	}
+	for (const TPair<FIntPoint, FMeshPlacementInfo>& Forced : RoomData->ForcedFloorPlacements)
+	{ AddUnloadedPath(Forced.Value.MeshAsset, OutPaths); }
+
+	// Walls, corners and columns
+	if (const UWallData* WallData = RoomData->WallStyleData.Get())
+	{
+		for (const FWallModule& Module : WallData->AvailableWallModules) AddWallModulePaths(Module, OutPaths);
+		AddUnloadedPath(WallData->DefaultCornerMesh, OutPaths);
+		AddUnloadedPath(WallData->WallColumnMesh, OutPaths);
+	}
+	for (const FForcedWallPlacement& Forced : RoomData->ForcedWallPlacements) AddWallModulePaths(Forced.WallModule, OutPaths);
+
+	// Door frames and side fills (style pool entries and manual doorways can use their own door data)
+	if (const UDoorData* DoorData = RoomData->DoorStyleData.Get())
+	{
+		AddDoorDataPaths(DoorData, OutPaths);
+		for (const UDoorData* PoolEntry : DoorData->DoorStylePool) AddDoorDataPaths(PoolEntry, OutPaths);
+	}
+	for (const FFixedDoorLocation& Forced : RoomData->ForcedDoorways) AddDoorDataPaths(Forced.DoorData, OutPaths);
+
+	// Ceiling
+	if (const UCeilingData* CeilingData = RoomData->CeilingStyleData.Get())
+	{
+		for (const FMeshPlacementInfo& Tile : CeilingData->CeilingTilePool) AddUnloadedPath(Tile.MeshAsset, OutPaths);
+	}
+	for (const FForcedCeilingPlacement& Forced : RoomData->ForcedCeilingPlacements)
+	{ AddUnloadedPath(Forced.TileInfo.MeshAsset, OutPaths); }
+}
 #pragma endregion
 
 #pragma region Transform Operations
@@ -317,15 +487,20 @@ const FTransform& ParentTransform, FVector FallbackOffset)
 #pragma endregion
 
 #pragma region Weighted Selection
-const FWallModule* URoomGenerationHelpers::SelectWeightedWallModule(const TArray<FWallModule>& Modules)
+const FWallModule* URoomGenerationHelpers::SelectWeightedWallModule(const TArray<FWallModule>& Modules, FRandomStream& Stream)
 {
 	return SelectWeightedRandom<FWallModule>(Modules,
-		[](const FWallModule& Module) { return Module.PlacementWeight; });
+		[](const FWallModule& Module) { return Module.PlacementWeight; }, Stream);
 }
 
-const FMeshPlacementInfo* URoomGenerationHelpers::SelectWeightedMeshPlacement(const TArray<FMeshPlacementInfo>& MeshPool)
+const FMeshPlacementInfo* URoomGenerationHelpers::SelectWeightedMeshPlacement(const TArray<FMeshPlacementInfo>& MeshPool, FRandomStream& Stream)
 {
 	return SelectWeightedRandom<FMeshPlacementInfo>(MeshPool,
-		[](const FMeshPlacementInfo& Info) { return Info.PlacementWeight; });
+		[](const FMeshPlacementInfo& Info) { return Info.PlacementWeight; }, Stream);
+}
+
+void URoomGenerationHelpers::BuildMeshPlacementAliasTable(const TArray<FMeshPlacementInfo>& MeshPool, FKernelAliasTable& OutTable)
+{
+	BuildWeightedAliasTable(MeshPool, [](const FMeshPlacementInfo& Info) { return Info.PlacementWeight; }, OutTable);
 }
 #pragma endregion
\ No newline at end of file
@@ -24,8 +24,12 @@ TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap,
 		return nullptr;
 	}
 
-	// Check if we already have an ISM component for this mesh
-	if (ComponentMap.Contains(MeshAsset)) return ComponentMap[MeshAsset];
+	// Check if we already have an ISM component for this mesh (drop it if it was destroyed behind our back)
+	if (UInstancedStaticMeshComponent** Existing = ComponentMap.Find(MeshAsset))
+	{
+		if (IsValid(*Existing)) return *Existing;
+		ComponentMap.Remove(MeshAsset);
+	}
 
 	// Load and validate mesh using generation helper
 	UStaticMesh* StaticMesh = URoomGenerationHelpers:: LoadAndValidateMesh(
@@ -94,17 +98,131 @@ const FVector& WorldOffset)
 int32 URoomSpawnerHelpers::SpawnMeshInstances(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
 const FVector& WorldOffset)
 {
-	if (!ISMComponent) return 0;
+	if (!ISMComponent || LocalTransforms.Num() == 0) return 0;
+
+	// One bulk add, render state and navigation are updated once for the whole array
+	if (WorldOffset.IsZero())
+	{
+		ISMComponent->AddInstances(LocalTransforms, false);
+	}
+	else
+	{
+		ISMComponent->AddInstances(LocalToWorldTransforms(LocalTransforms, WorldOffset), false);
+	}
+
+	return LocalTransforms.Num();
+}
+
+int32 URoomSpawnerHelpers::SpawnMeshInstanceBatches(AActor* Owner, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, const FString& ComponentNamePrefix,
+const FVector& WorldOffset, bool bLogWarnings)
+{
 	int32 SpawnedCount = 0;
 
-	for (const FTransform& LocalTransform : LocalTransforms)
+	for (const TPair<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batch : Batches)
 	{
-		int32 InstanceIndex = SpawnMeshInstance(ISMComponent, LocalTransform, WorldOffset);
-		if (InstanceIndex >= 0) SpawnedCount++;
+		UInstancedStaticMeshComponent* ISM = GetOrCreateISMComponent(Owner, Batch.Key, ComponentMap, ComponentNamePrefix, bLogWarnings);
+		SpawnedCount += SpawnMeshInstances(ISM, Batch.Value, WorldOffset);
 	}
 
 	return SpawnedCount;
 }
+
+namespace
+{
+	/* Transform quantized to 0.1cm / 0.01deg / 0.001 scale, so regenerated placements match existing instances */
+	struct FInstanceTransformKey
+	{
+		FIntVector Location;
+		FIntVector Rotation;
+		FIntVector Scale;
+
+		explicit FInstanceTransformKey(const FTransform& Transform)
+		{
+			const FVector Loc = Transform.GetLocation() * 10.0;
+			const FRotator Rot = Transform.Rotator().GetNormalized();
+			const FVector Scl = Transform.GetScale3D() * 1000.0;
+			Location = FIntVector(FMath::RoundToInt32(Loc.X), FMath::RoundToInt32(Loc.Y), FMath::RoundToInt32(Loc.Z));
+			Rotation = FIntVector(FMath::RoundToInt32(Rot.Pitch * 100.0), FMath::RoundToInt32(Rot.Yaw * 100.0),
+				FMath::RoundToInt32(Rot.Roll * 100.0));
+			Scale = FIntVector(FMath::RoundToInt32(Scl.X), FMath::RoundToInt32(Scl.Y), FMath::RoundToInt32(Scl.Z));
+		}
+
+		bool operator==(const FInstanceTransformKey& Other) const
+		{ return Location == Other.Location && Rotation == Other.Rotation && Scale == Other.Scale; }
+
+		friend uint32 GetTypeHash(const FInstanceTransformKey& Key)
+		{ return HashCombine(HashCombine(GetTypeHash(Key.Location), GetTypeHash(Key.Rotation)), GetTypeHash(Key.Scale)); }
+	};
+
+	/* Diff one component against its target transforms, returns slots touched */
+	int32 SyncComponentInstances(UInstancedStaticMeshComponent* ISM, const TArray<FTransform>& Targets)
+	{
+		// Unmatched target indices per transform (multiset, duplicates allowed)
+		TMap<FInstanceTransformKey, TArray<int32>> Unmatched;
+		Unmatched.Reserve(Targets.Num());
+		for (int32 i = Targets.Num() - 1; i >= 0; --i) Unmatched.FindOrAdd(FInstanceTransformKey(Targets[i])).Add(i);
+
+		// Keep every existing instance that still has a target, the rest become free slots
+		TBitArray<> Matched(false, Targets.Num());
+		TArray<int32> FreeSlots;
+		const int32 ExistingCount = ISM->GetInstanceCount();
+		for (int32 Slot = 0; Slot < ExistingCount; ++Slot)
+		{
+			FTransform Current;
+			ISM->GetInstanceTransform(Slot, Current, false);
+
+			TArray<int32>* Candidates = Unmatched.Find(FInstanceTransformKey(Current));
+			if (Candidates && Candidates->Num() > 0) Matched[Candidates->Pop(EAllowShrinking::No)] = true;
+			else FreeSlots.Add(Slot);
+		}
+
+		TArray<FTransform> Missing;
+		for (int32 i = 0; i < Targets.Num(); ++i) { if (!Matched[i]) Missing.Add(Targets[i]); }
+
+		// Reuse free slots in place, then remove or add only the difference
+		const int32 NumUpdates = FMath::Min(FreeSlots.Num(), Missing.Num());
+		for (int32 i = 0; i < NumUpdates; ++i) ISM->UpdateInstanceTransform(FreeSlots[i], Missing[i], false, false, true);
+		if (NumUpdates > 0) ISM->MarkRenderStateDirty();
+
+		if (FreeSlots.Num() > NumUpdates)
+		{
+			ISM->RemoveInstances(TArray<int32>(FreeSlots.GetData() + NumUpdates, FreeSlots.Num() - NumUpdates));
+		}
+		else if (Missing.Num() > NumUpdates)
+		{
+			ISM->AddInstances(TArray<FTransform>(Missing.GetData() + NumUpdates, Missing.Num() - NumUpdates), false);
+		}
+
+		return FMath::Max(FreeSlots.Num(), Missing.Num());
+	}
+}
+
+int32 URoomSpawnerHelpers::SyncMeshInstanceBatches(AActor* Owner, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, const FString& ComponentNamePrefix,
+const FVector& WorldOffset, bool bLogWarnings)
+{
+	int32 ChangedCount = 0;
+
+	// Meshes no longer placed keep their (now empty) component
+	for (const TPair<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& Pair : ComponentMap)
+	{
+		if (Batches.Contains(Pair.Key) || !IsValid(Pair.Value) || Pair.Value->GetInstanceCount() == 0) continue;
+		ChangedCount += Pair.Value->GetInstanceCount();
+		Pair.Value->ClearInstances();
+	}
+
+	for (const TPair<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batch : Batches)
+	{
+		UInstancedStaticMeshComponent* ISM = GetOrCreateISMComponent(Owner, Batch.Key, ComponentMap, ComponentNamePrefix, bLogWarnings);
+		if (!ISM) continue;
+
+		ChangedCount += WorldOffset.IsZero() ? SyncComponentInstances(ISM, Batch.Value)
+			: SyncComponentInstances(ISM, LocalToWorldTransforms(Batch.Value, WorldOffset));
+	}
+
+	return ChangedCount;
+}
   
 // TRANSFORM UTILITIES
 FTransform URoomSpawnerHelpers::LocalToWorldTransform(const FTransform& LocalTransform, const FVector& WorldOffset)
@@ -129,105 +247,29 @@ const TArray<FTransform>& LocalTransforms, const FVector& WorldOffset)
 }
 
 #pragma region Wall Spawning
-void URoomSpawnerHelpers::SpawnWallSegment(AActor* Owner, const FPlacedWallInfo& PlacedWall,
+void URoomSpawnerHelpers::SpawnWallSegment(AActor* Owner, const FPlacedWallInfo& PlacedWall, const FWallModule& Module,
 	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& WallComponents, const FVector& RoomOrigin,
 	const FString& ComponentPrefix, class UDebugHelpers* DebugHelpers)
 {
-	// SPAWN BASE MESH (Required - Base Layer)
-	UInstancedStaticMeshComponent* BottomISM = GetOrCreateISMComponent(
-		Owner,
-		PlacedWall.WallModule.BaseMesh,
-		WallComponents,
-		ComponentPrefix,
-		true
-	);
-
-	if (BottomISM)
-	{
-		int32 InstanceIndex = SpawnMeshInstance(BottomISM, PlacedWall.BottomTransform, RoomOrigin);
+	TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>> Batches;
+	AddWallSegmentToBatches(PlacedWall, Module, Batches);
 
-		if (InstanceIndex >= 0 && DebugHelpers)
-		{
-			DebugHelpers->LogVerbose(FString::Printf(
-				TEXT("  Spawned base mesh at edge %d, cell %d (instance %d)"),
-				(int32)PlacedWall.Edge, PlacedWall.StartCell, InstanceIndex
-			));
-		}
-	}
+	const int32 SpawnedCount = SpawnMeshInstanceBatches(Owner, Batches, WallComponents, ComponentPrefix, RoomOrigin);
 
-	// SPAWN MIDDLE1 MESH (Optional - First Middle Layer)
-	if (!PlacedWall.WallModule.MiddleMesh1.IsNull())
+	if (DebugHelpers)
 	{
-		UInstancedStaticMeshComponent* Middle1ISM = GetOrCreateISMComponent(
-			Owner,
-			PlacedWall.WallModule.MiddleMesh1,
-			WallComponents,
-			ComponentPrefix,
-			true
-		);
-
-		if (Middle1ISM)
-		{
-			int32 InstanceIndex = SpawnMeshInstance(Middle1ISM, PlacedWall.Middle1Transform, RoomOrigin);
-
-			if (InstanceIndex >= 0 && DebugHelpers)
-			{
-				DebugHelpers->LogVerbose(FString::Printf(
-					TEXT("  Spawned middle1 mesh at edge %d, cell %d (instance %d)"),
-					(int32)PlacedWall.Edge, PlacedWall.StartCell, InstanceIndex
-				));
-			}
-		}
-	}
-
-	// SPAWN MIDDLE2 MESH (Optional - Second Middle Layer)
-	if (!PlacedWall. WallModule.MiddleMesh2.IsNull())
-	{
-		UInstancedStaticMeshComponent* Middle2ISM = GetOrCreateISMComponent(
-			Owner,
-			PlacedWall.WallModule. MiddleMesh2,
-			WallComponents,
-			ComponentPrefix,
-			true
-		);
-
-		if (Middle2ISM)
-		{
-			int32 InstanceIndex = SpawnMeshInstance(Middle2ISM, PlacedWall.Middle2Transform, RoomOrigin);
-
-			if (InstanceIndex >= 0 && DebugHelpers)
-			{
-				DebugHelpers->LogVerbose(FString::Printf(
-					TEXT("  Spawned middle2 mesh at edge %d, cell %d (instance %d)"),
-					(int32)PlacedWall.Edge, PlacedWall.StartCell, InstanceIndex
-				));
-			}
-		}
+		DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %d wall layers at edge %d, cell %d"),
+			SpawnedCount, (int32)PlacedWall.Edge, PlacedWall.StartCell));
 	}
+}
 
-	// SPAWN TOP MESH (Optional - Top Layer/Cap)
-	if (!PlacedWall. WallModule.TopMesh. IsNull())
-	{
-		UInstancedStaticMeshComponent* TopISM = GetOrCreateISMComponent(
-			Owner,
-			PlacedWall. WallModule.TopMesh,
-			WallComponents,
-			ComponentPrefix,
-			true
-		);
-
-		if (TopISM)
-		{
-			int32 InstanceIndex = SpawnMeshInstance(TopISM, PlacedWall.TopTransform, RoomOrigin);
-
-			if (InstanceIndex >= 0 && DebugHelpers)
-			{
-				DebugHelpers->LogVerbose(FString::Printf(
-					TEXT("  Spawned top mesh at edge %d, cell %d (instance %d)"),
-					(int32)PlacedWall.Edge, PlacedWall.StartCell, InstanceIndex
-				));
-			}
-		}
-	}
+void URoomSpawnerHelpers::AddWallSegmentToBatches(const FPlacedWallInfo& PlacedWall, const FWallModule& Module,
+	TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches)
+{
+	// Base layer is required, the rest are optional
+	if (!Module.BaseMesh.IsNull()) Batches.FindOrAdd(Module.BaseMesh).Add(PlacedWall.BottomTransform);
+	if (!Module.MiddleMesh1.IsNull()) Batches.FindOrAdd(Module.MiddleMesh1).Add(PlacedWall.Middle1Transform);
+	if (!Module.MiddleMesh2.IsNull()) Batches.FindOrAdd(Module.MiddleMesh2).Add(PlacedWall.Middle2Transform);
+	if (!Module.TopMesh.IsNull()) Batches.FindOrAdd(Module.TopMesh).Add(PlacedWall.TopTransform);
 }
 #pragma endregion
\ No newline at end of file
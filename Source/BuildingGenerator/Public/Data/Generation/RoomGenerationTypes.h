@@ -41,6 +41,16 @@ enum class EDoorwaySideFill :  uint8
 	CornerPieces    UMETA(DisplayName = "Corner Pieces")
 };
 
+/* Mesh groups a room spawns, each with its own ISM components or building pool range */
+UENUM(BlueprintType)
+enum class ERoomMeshCategory : uint8
+{
+	Floor,
+	Wall,
+	Corner,
+	Ceiling
+};
+
 
 // --- Mesh Placement Info  ---
 USTRUCT(BlueprintType)
@@ -65,33 +75,52 @@ struct FMeshPlacementInfo
 	TArray<int32> AllowedRotations = {0}; 
 };
 
-/* Struct to track placed mesh information */
-USTRUCT()
+/* Compact placement record for a floor or ceiling tile
+ * The mesh is an index into the generating room's mesh palette (URoomGenerator::GetPlacedMeshPalette) and the
+ * transform is derived on demand, so records carry no soft paths or arrays. */
+USTRUCT(BlueprintType)
 struct FPlacedMeshInfo
 {
 	GENERATED_BODY()
 
-	// Grid position (top-left cell)
+	// Index into the room mesh palette
 	UPROPERTY()
-	FIntPoint GridPosition;
+	int32 MeshIndex;
 
-	// Size in cells
+	// Grid position (top-left cell), X in the low 16 bits and Y in the high 16 bits
 	UPROPERTY()
-	FIntPoint GridFootprint;
+	uint32 PackedGridPosition;
 
-	// Rotation angle (0, 90, 180, 270)
+	// Size in cells
 	UPROPERTY()
-	int32 Rotation;
+	uint8 FootprintX;
 
-	// Mesh placement info from data asset
 	UPROPERTY()
-	FMeshPlacementInfo MeshInfo;
+	uint8 FootprintY;
 
-	// World transform for spawning
+	// Rotation in 90° steps (0-3)
 	UPROPERTY()
-	FTransform LocalTransform;
+	uint8 RotationSteps;
+
+	FPlacedMeshInfo() : MeshIndex(INDEX_NONE), PackedGridPosition(0), FootprintX(0), FootprintY(0), RotationSteps(0) {}
+
+	FIntPoint GetGridPosition() const
+	{
+		return FIntPoint(static_cast<int16>(PackedGridPosition & 0xFFFF), static_cast<int16>(PackedGridPosition >> 16));
+	}
+
+	FIntPoint GetFootprint() const { return FIntPoint(FootprintX, FootprintY); }
+
+	/* Rotation in degrees (0, 90, 180, 270) */
+	int32 GetRotation() const { return RotationSteps * 90; }
 
-	FPlacedMeshInfo() : GridPosition(FIntPoint:: ZeroValue), GridFootprint(FIntPoint::ZeroValue), Rotation(0) {}
+	void SetPlacement(FIntPoint GridPosition, FIntPoint Footprint, int32 Rotation)
+	{
+		PackedGridPosition = static_cast<uint16>(GridPosition.X) | (static_cast<uint32>(static_cast<uint16>(GridPosition.Y)) << 16);
+		FootprintX = static_cast<uint8>(FMath::Clamp(Footprint.X, 0, 255));
+		FootprintY = static_cast<uint8>(FMath::Clamp(Footprint.Y, 0, 255));
+		RotationSteps = static_cast<uint8>(((Rotation % 360 + 360) % 360) / 90);
+	}
 };
 
 // Struct for designer-defined rectangular empty regions
@@ -174,9 +203,9 @@ struct FPlacedWallInfo
 	UPROPERTY()
 	int32 SpanLength;
 
-	// Wall module used
+	// Wall module used, index into the room wall module palette (URoomGenerator::GetPlacedWallModulePalette)
 	UPROPERTY()
-	FWallModule WallModule;
+	int32 ModuleIndex;
 
 	// World transforms for each mesh layer
 	UPROPERTY()
@@ -195,6 +224,7 @@ struct FPlacedWallInfo
 		: Edge(EWallEdge::North)
 		, StartCell(0)
 		, SpanLength(0)
+		, ModuleIndex(INDEX_NONE)
 	{}
 };
 
@@ -358,37 +388,11 @@ struct FPlacedCornerInfo
 	{}
 };
 
-/* Information about a placed ceiling tile */
+/* Information about a placed ceiling tile (same compact record as floor tiles, palette shared with the floor) */
 USTRUCT(BlueprintType)
-struct FPlacedCeilingInfo
+struct FPlacedCeilingInfo : public FPlacedMeshInfo
 {
 	GENERATED_BODY()
-	// Grid position (top-left cell)
-	UPROPERTY()
-	FIntPoint GridCoordinate;
-
-	// Size in cells (tile size like 4x4, 2x2, 1x1)
-	UPROPERTY()
-	FIntPoint TileSize;
-
-	// Rotation angle (0, 90, 180, 270) - if needed
-	UPROPERTY()
-	int32 Rotation;
-
-	// Mesh placement info from data asset
-	UPROPERTY()
-	FMeshPlacementInfo MeshInfo;
-
-	// World transform for spawning
-	UPROPERTY()
-	FTransform LocalTransform;  // ← CHANGED:  Match floor naming
-
-	// Constructor with proper initialization
-	FPlacedCeilingInfo() 
-		: GridCoordinate(FIntPoint::  ZeroValue)
-		, TileSize(FIntPoint:: ZeroValue)
-		, Rotation(0)
-	{}
 };
 
 /* Forced ceiling placement structure (designer override system) */
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "HAL/CriticalSection.h"
 #include "CeilingData.generated.h"
 
 struct FMeshPlacementInfo;
+struct FKernelTilePool;
 
 UCLASS()
 class BUILDINGGENERATOR_API UCeilingData : public UDataAsset
@@ -25,4 +27,20 @@ public:
 	// Rotation offset for all ceiling tiles (0, 180, 0) to flip floor tiles upside down for ceiling
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ceiling Settings")
 	FRotator CeilingRotation = FRotator(0.0f, 0.0f, 0.0f);
+
+#pragma region Compiled Pools
+	/* CeilingTilePool bucketed by footprint with sampling tables, built on first use and shared by every room */
+	TSharedRef<const FKernelTilePool, ESPMode::ThreadSafe> GetCompiledCeilingTilePool() const;
+
+	/* Drop compiled pools (rebuilt on next use) */
+	void InvalidateCompiledPools();
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+#pragma endregion
+
+private:
+	mutable TSharedPtr<const FKernelTilePool, ESPMode::ThreadSafe> CompiledCeilingTilePool;
+	mutable FCriticalSection CompiledPoolLock;
 };
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "HAL/CriticalSection.h"
 #include "FloorData.generated.h"
 
 struct FMeshPlacementInfo;
+struct FKernelTilePool;
 
 UCLASS()
 class BUILDINGGENERATOR_API UFloorData : public UDataAsset
@@ -28,4 +30,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Floor Clutter")
 	float ClutterPlacementChance = 0.25f;
 
+#pragma region Compiled Pools
+	/* FloorTilePool bucketed by footprint with sampling tables, built on first use and shared by every room */
+	TSharedRef<const FKernelTilePool, ESPMode::ThreadSafe> GetCompiledFloorTilePool() const;
+
+	/* Drop compiled pools (rebuilt on next use) */
+	void InvalidateCompiledPools();
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+#pragma endregion
+
+private:
+	mutable TSharedPtr<const FKernelTilePool, ESPMode::ThreadSafe> CompiledFloorTilePool;
+	mutable FCriticalSection CompiledPoolLock;
 };
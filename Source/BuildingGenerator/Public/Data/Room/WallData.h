@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/ObjectKey.h"
 #include "WallData.generated.h"
 
 struct FWallModule;
+struct FKernelWallModuleTable;
 
 UCLASS()
 class BUILDINGGENERATOR_API UWallData : public UDataAsset
@@ -101,4 +104,25 @@ public:
 	// Rotation offset for columns (if needed)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall Decorations", meta = (EditCondition = "bEnableWallColumns"))
 	FRotator ColumnRotationOffset = FRotator::ZeroRotator;
+
+#pragma region Compiled Pools
+	/* AvailableWallModules bucketed by footprint with sampling tables, built on first use and shared by every room */
+	TSharedRef<const FKernelWallModuleTable, ESPMode::ThreadSafe> GetCompiledWallModuleTable() const;
+
+	/* Stacking socket (TopBackCenter) of Mesh relative to the mesh, or WallHeight straight up when it has none
+	 * Resolved once per mesh and shared by every segment and room using this style */
+	FTransform GetStackSocketTransform(UStaticMesh* Mesh) const;
+
+	/* Drop compiled pools and socket transforms (rebuilt on next use) */
+	void InvalidateCompiledPools();
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+#pragma endregion
+
+private:
+	mutable TSharedPtr<const FKernelWallModuleTable, ESPMode::ThreadSafe> CompiledWallModuleTable;
+	mutable TMap<TObjectKey<UStaticMesh>, FTransform> StackSocketTransforms;
+	mutable FCriticalSection CompiledPoolLock;
 };
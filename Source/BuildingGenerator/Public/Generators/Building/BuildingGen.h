@@ -4,13 +4,135 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Data/Generation/RoomGenerationTypes.h"
 #include "BuildingGen.generated.h"
 
+class UBuildingGen;
+class URoomData;
+class URoomGenerator;
+struct FStreamableHandle;
+
+/* One room to generate in a batch */
+USTRUCT(BlueprintType)
+struct FRoomBatchJob
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Batch")
+	TObjectPtr<URoomData> RoomData = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Batch")
+	FIntPoint GridSize = FIntPoint(10, 10);
+
+	/* Room seed (-1 = pick a random seed) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Batch")
+	int32 Seed = -1;
+
+	/* Generator to run (None = UUniformRoomGenerator) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Batch")
+	TSubclassOf<URoomGenerator> GeneratorClass;
+};
+
+/* Placement records of one generated room, ready to be spawned on the game thread */
+USTRUCT(BlueprintType)
+struct FRoomBatchResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	bool bSuccess = false;
+
+	/* Seed actually used (resolved from -1) */
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	int32 Seed = -1;
+
+	/* Parameters to rebuild tile transforms (URoomGenerator::MakeFloorTileTransform / MakeCeilingTileTransform) */
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	float CellSize = 100.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	float CeilingHeight = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	FRotator CeilingRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	TArray<FPlacedMeshInfo> FloorMeshes;
+
+	UPROPERTY()
+	TArray<FPlacedWallInfo> Walls;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	TArray<FPlacedCornerInfo> Corners;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	TArray<FPlacedDoorwayInfo> Doorways;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	TArray<FPlacedCeilingInfo> CeilingTiles;
+
+	/* Meshes indexed by FloorMeshes/CeilingTiles (MeshIndex) */
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	TArray<TSoftObjectPtr<UStaticMesh>> MeshPalette;
+
+	/* Wall modules indexed by Walls (ModuleIndex) */
+	UPROPERTY(BlueprintReadOnly, Category = "Room Batch")
+	TArray<FWallModule> WallModulePalette;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRoomBatchFinished, UBuildingGen*, BuildingGen, const TArray<FRoomBatchResult>&, Results);
+
 /**
- * 
- */
+ * BuildingGen - Building-scale generation front end
+ * Runs the room generation stages for many rooms at once on the task graph. Only placement records are produced,
+ * spawning the instances stays on the game thread (ARoomSpawner). */
 UCLASS()
 class BUILDINGGENERATOR_API UBuildingGen : public UObject
 {
 	GENERATED_BODY()
+
+public:
+#pragma region Batch Generation
+	/* Stream the assets of every job asynchronously, then generate them in parallel
+	 * (CreateGrid -> Floor -> Walls -> Corners -> Doorways -> Ceiling). Must be called on the game thread, which is
+	 * never blocked on the asset loader. OnBatchFinished gets the results, matching Jobs index for index.
+	 * @return False if a batch is already running or Jobs is empty */
+	UFUNCTION(BlueprintCallable, Category = "Building Generation")
+	bool GenerateRoomBatch(const TArray<FRoomBatchJob>& Jobs);
+
+	/* True from GenerateRoomBatch until OnBatchFinished is broadcast */
+	UFUNCTION(BlueprintPure, Category = "Building Generation")
+	bool IsBatchRunning() const { return bBatchRunning; }
+
+	/* Fired on the game thread once every job of the batch is generated */
+	UPROPERTY(BlueprintAssignable, Category = "Building Generation")
+	FOnRoomBatchFinished OnBatchFinished;
+#pragma endregion
+
+private:
+#pragma region Batch Helpers
+	/* Style assets streamed: request every mesh they reference (one request for the whole batch) */
+	void OnBatchStylesLoaded();
+
+	/* Meshes streamed: warm the compiled tile pools, so worker threads never build them, then run the batch */
+	void OnBatchMeshesLoaded();
+
+	/* Create the generators, run their stages with a ParallelFor and broadcast OnBatchFinished */
+	void RunBatch();
+
+	/* Request Paths and call OnLoaded once they are resident (right away if there is nothing to load) */
+	void RequestBatchAssets(TArray<FSoftObjectPath>&& Paths, void (UBuildingGen::*OnLoaded)());
+
+	/* Create the grid and run the generator's stage graph (safe off the game thread once assets are loaded) */
+	static bool RunRoomStages(URoomGenerator* Generator);
+#pragma endregion
+
+	/* Jobs of the running batch */
+	UPROPERTY()
+	TArray<FRoomBatchJob> PendingJobs;
+
+	/* Keep the streamed assets alive until the batch is done */
+	TArray<TSharedPtr<FStreamableHandle>> AssetHandles;
+
+	bool bBatchRunning = false;
 };
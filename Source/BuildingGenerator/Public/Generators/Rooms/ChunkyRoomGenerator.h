@@ -9,6 +9,13 @@
 // Forward declarations
 enum class EWallEdge : uint8;
 
+/** Maximal straight run of perimeter cells facing one edge (advances along +Y for North/South, +X for East/West) */
+struct FChunkyWallRun
+{
+	FIntPoint StartCell = FIntPoint::ZeroValue;
+	int32 Length = 0;
+};
+
 UCLASS()
 class BUILDINGGENERATOR_API UChunkyRoomGenerator : public URoomGenerator
 {
@@ -17,6 +24,9 @@ class BUILDINGGENERATOR_API UChunkyRoomGenerator : public URoomGenerator
 public:
 	/** Override:  Create chunky grid pattern */
 	virtual void CreateGrid() override;
+
+	/** Override: also forget the corner cells and perimeter masks of the previous grid */
+	virtual void ClearGrid() override;
 	
 #pragma region Room Generation Interface
 	/** Generate floor meshes - uses base implementation (fills all ECT_FloorMesh cells) */
@@ -56,28 +66,28 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Chunky Generation", meta = (ClampMin = "0.3", ClampMax = "0.95"))
 	float BaseRoomPercentage = 0.7f;
 	
-	/** Random seed for generation (-1 = random each time, 0+ = deterministic) */
+	/** Random seed override for generation (-1 = use the room seed from Initialize, 0+ = deterministic) */
 	UPROPERTY(EditAnywhere, Category = "Chunky Generation")
 	int32 RandomSeed = -1;
 #pragma endregion
 	
 #pragma region Internal Helpers
 #pragma region Internal Helper variables
-	/** Random stream for deterministic generation */
-	FRandomStream RandomStream;
-	
 	/** Base room bounds (calculated during CreateGrid) */
 	FIntPoint BaseRoomStart;
 	FIntPoint BaseRoomSize;
 	
-	/** Corner cells marked during GenerateCorners (walls will skip these) */
-	TSet<FIntPoint> CornerCells;
+	/** Corner cells marked during GenerateCorners, one bit per grid index (walls skip the same cells) */
+	TBitArray<> CornerCellBits;
+
+	/** Per-cell 4-bit mask of void/out-of-bounds neighbours (N=1, S=2, E=4, W=8), floor cells only */
+	TArray<uint8> PerimeterMasks;
 #pragma endregion
 	/** Mark a rectangular area as floor cells */
 	void MarkRectangle(int32 StartX, int32 StartY, int32 Width, int32 Height);
 	
 	/** Add a random protrusion extending from the base room */
-	void AddRandomProtrusion();
+	void AddRandomProtrusion(FRandomStream& Stream);
 	
 	/** Check if a cell has a floor neighbor in a specific direction */
 	bool HasFloorNeighbor(FIntPoint Cell, FIntPoint Direction) const;
@@ -90,11 +100,13 @@ public:
 	/** Get directional offset for a wall edge */
 	FIntPoint GetDirectionOffset(EWallEdge Direction) const;
 	
-	/** Get perimeter cells for a specific edge direction (replaces GetEdgeCellIndices for chunky rooms) */
-	TArray<FIntPoint> GetPerimeterCellsForEdge(EWallEdge Edge) const;
+	/** Single pass over the grid: rebuild PerimeterMasks and, if OutRuns is set, emit the maximal wall runs of all
+	 * four edges (OutRuns[0..3] = North, South, East, West, cells GetCornerFromMask classifies as corners excluded
+	 * when bSkipCornerCells) */
+	void TracePerimeter(TKernelScratchArray<FChunkyWallRun>* OutRuns, bool bSkipCornerCells);
 	
-	/** Fill wall edge using base class greedy logic adapted for chunky perimeter */
-	void FillChunkyWallEdge(EWallEdge Edge);
+	/** Pack the straight runs of one edge with wall modules */
+	void FillChunkyWallEdge(EWallEdge Edge, const TKernelScratchArray<FChunkyWallRun>& Runs, FRandomStream& Stream);
 	
 	/** Calculate wall position for a segment starting at a specific cell */
 	FVector CalculateWallPositionForSegment(EWallEdge Direction, FIntPoint StartCell, int32 ModuleFootprint,
@@ -102,11 +114,8 @@ public:
 #pragma endregion
 	
 #pragma region Corner Generation Helper functions
-	/** Check if a floor cell is a corner (has void on 2+ adjacent sides) */
-	bool IsCornerCell(FIntPoint Cell, TArray<EWallEdge>& OutAdjacentVoidEdges) const;
-	
-	/** Determine corner position (NE/NW/SE/SW) from adjacent void edges */
-	ECornerPosition GetCornerPositionFromEdges(const TArray<EWallEdge>& AdjacentEdges) const;
+	/** Classify a neighbour mask through the 16-entry corner table (corner = void on exactly two adjacent sides) */
+	static bool GetCornerFromMask(uint8 NeighbourMask, ECornerPosition& OutCorner);
 
 	/** Get position offset for a specific corner type from WallData */
 	FVector GetCornerPositionOffset(ECornerPosition  CornerType) const;
@@ -0,0 +1,312 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+/**
+ * RoomGenerationKernel - Engine-free core of room generation
+ * Works purely on POD descriptors (no UObjects, no asset loading) so it can be driven by URoomGenerator
+ * or by a headless tool that only links Core. Meshes and wall modules are referenced by caller-defined IDs. */
+
+#pragma region Scratch Memory
+/* Per-generation temporaries, bump-allocated from the calling thread's FMemStack
+ * Lifetime rule: every stage (and every kernel entry point that allocates) opens an FMemMark on entry, and all scratch
+ * arrays it creates are released when that mark goes out of scope on return, so they must never be stored past it */
+template<typename T>
+using TKernelScratchArray = TArray<T, TMemStackAllocator<>>;
+#pragma endregion
+
+#pragma region Kernel Descriptors
+/* Cell states tracked by the kernel (mirrors EGridCellType value for value, without the reflection dependency) */
+enum class EKernelCellType : uint8
+{
+	ECT_Empty,
+	ECT_FloorMesh,
+	ECT_WallMesh,
+	ECT_Doorway,
+	ECT_Reserved,
+	ECT_Custom,
+	ECT_Void
+};
+
+/* Tile pool entry (FMeshPlacementInfo without the asset reference) */
+struct FKernelTileDesc
+{
+	/* Unrotated footprint in cells */
+	FIntPoint Footprint = FIntPoint(1, 1);
+
+	/* Relative selection weight */
+	float Weight = 1.0f;
+
+	/* Allowed yaw rotations as quarter-turn bits (bit 0 = 0°, 1 = 90°, 2 = 180°, 3 = 270°), 0 = always unrotated */
+	uint8 RotationMask = 0;
+
+	/* Caller-defined mesh ID (index into the source pool) */
+	int32 MeshId = INDEX_NONE;
+};
+
+/* Wall module entry (FWallModule without the asset references) */
+struct FKernelWallModuleDesc
+{
+	/* Length along the wall in cells */
+	int32 Footprint = 1;
+
+	/* Relative selection weight */
+	float Weight = 1.0f;
+
+	/* Caller-defined module ID (index into the source pool) */
+	int32 ModuleId = INDEX_NONE;
+};
+
+/* Tile placed by the kernel */
+struct FKernelTilePlacement
+{
+	FIntPoint Position = FIntPoint::ZeroValue;
+	FIntPoint Footprint = FIntPoint(1, 1);
+	int32 Rotation = 0;
+	int32 MeshId = INDEX_NONE;
+};
+
+/* Wall module placed along a straight run (StartIndex is relative to the run start) */
+struct FKernelWallSpan
+{
+	int32 StartIndex = 0;
+	int32 Length = 0;
+	int32 ModuleId = INDEX_NONE;
+};
+#pragma endregion
+
+#pragma region Weighted Sampling
+/**
+ * FKernelAliasTable - Walker/Vose alias table for O(1) weighted sampling
+ * Build once per pool (or per footprint bucket), then Sample costs one column pick and one coin flip.
+ * Negative weights count as zero, an all-zero pool samples uniformly. */
+struct BUILDINGGENERATOR_API FKernelAliasTable
+{
+	void Build(TArrayView<const float> Weights);
+	void Reset() { Probability.Reset(); Alias.Reset(); }
+
+	/* Index into the weights passed to Build (INDEX_NONE when empty) */
+	int32 Sample(FRandomStream& Stream) const
+	{
+		if (Probability.Num() == 0) return INDEX_NONE;
+		const int32 Column = Stream.RandRange(0, Probability.Num() - 1);
+		return Stream.FRand() < Probability[Column] ? Column : Alias[Column];
+	}
+
+	int32 Num() const { return Probability.Num(); }
+
+private:
+	TArray<float> Probability;
+	TArray<int32> Alias;
+};
+
+/* Tiles that cover one target size (either orientation), in pool order, with their sampling table */
+struct FKernelTileBucket
+{
+	TArray<int32> Candidates;
+	FKernelAliasTable Table;
+};
+
+/**
+ * FKernelTilePool - Tile descriptors compiled into footprint buckets
+ * Immutable once built, so one instance can be shared by every room (and thread) using the same style asset. */
+struct BUILDINGGENERATOR_API FKernelTilePool
+{
+	void Build(TArray<FKernelTileDesc>&& InDescs);
+
+	const TArray<FKernelTileDesc>& GetDescs() const { return Descs; }
+
+	/* Bucket for a target size (nullptr if no tile covers it) */
+	const FKernelTileBucket* FindBucket(FIntPoint TargetSize) const { return Buckets.Find(TargetSize); }
+
+private:
+	TArray<FKernelTileDesc> Descs;
+	TMap<FIntPoint, FKernelTileBucket> Buckets;
+};
+
+/* Wall modules of one footprint, in pool order, with their sampling table */
+struct FKernelWallBucket
+{
+	TArray<int32> Candidates;
+	FKernelAliasTable Table;
+};
+
+/**
+ * FKernelWallModuleTable - Wall module descriptors indexed by footprint
+ * Footprints whose modules all have zero weight are left out (unless every module does), so PlacementWeight 0
+ * disables a module. Immutable once built and shareable across rooms and threads like FKernelTilePool. */
+struct BUILDINGGENERATOR_API FKernelWallModuleTable
+{
+	void Build(TArray<FKernelWallModuleDesc>&& InDescs);
+
+	const TArray<FKernelWallModuleDesc>& GetDescs() const { return Descs; }
+
+	/* Usable footprints, largest first */
+	const TArray<int32>& GetFootprints() const { return Footprints; }
+
+	/* Weighted module pick for a footprint, returns ModuleId (INDEX_NONE if no module has it) */
+	int32 SampleModule(int32 Footprint, FRandomStream& Stream) const;
+
+private:
+	TArray<FKernelWallModuleDesc> Descs;
+	TArray<int32> Footprints;
+
+	/* Indexed by footprint */
+	TArray<FKernelWallBucket> Buckets;
+};
+#pragma endregion
+
+/**
+ * FRoomGenerationKernel - Typed occupancy grid plus the tile fill and wall packing algorithms
+ * Grid is row-major (Index = Y * GridSize.X + X), same layout URoomGenerator exposes (as EGridCellType) through GetGridState()
+ * Alongside the typed cells, one bitboard per cell type (64 cells per word, WordsPerRow words per row) is kept
+ * in sync so area queries test a whole row span with a few AND/shift operations.
+ * Queries against the free type (the type fills place into) are answered in O(1) from a summed-area table
+ * of blocked cells. Edits only mark the table dirty; it is rebuilt once before the next query, so a run of
+ * placements costs one O(W*H) pass instead of one per placement.
+ * Fills over the free type are driven by a MaxRects index of maximal free rectangles: size passes that cannot fit
+ * are skipped and origins are taken straight from the index in the same row-major order as a full scan. */
+class BUILDINGGENERATOR_API FRoomGenerationKernel
+{
+public:
+#pragma region Grid
+	/* Resize the grid and set every cell to InitialType
+	 * @param InFreeType - Cell type the summed-area table treats as free (FloorTargetCellType for floors) */
+	void Reset(FIntPoint InGridSize, EKernelCellType InitialType, EKernelCellType InFreeType = EKernelCellType::ECT_Empty);
+
+	/* Release all cells */
+	void Empty();
+
+	FIntPoint GetGridSize() const { return GridSize; }
+	EKernelCellType GetFreeType() const { return FreeType; }
+	const TArray<EKernelCellType>& GetCells() const { return Cells; }
+
+	bool IsValidCoord(FIntPoint Coord) const
+	{ return Coord.X >= 0 && Coord.X < GridSize.X && Coord.Y >= 0 && Coord.Y < GridSize.Y; }
+
+	int32 CoordToIndex(FIntPoint Coord) const { return Coord.Y * GridSize.X + Coord.X; }
+
+	/* Get cell type (ECT_Empty when out of bounds) */
+	EKernelCellType GetCell(FIntPoint Coord) const;
+
+	/* Set cell type, returns false when out of bounds */
+	bool SetCell(FIntPoint Coord, EKernelCellType CellType);
+
+	/* Replace every cell of type From with To, returns number of cells changed */
+	int32 ReplaceCells(EKernelCellType From, EKernelCellType To);
+
+	/* Count cells of a given type */
+	int32 CountCells(EKernelCellType CellType) const;
+
+	/* Cover every CellType cell with disjoint rectangles (greedy: longest run along X, grown along Y while the span stays full)
+	 * @return Number of rectangles appended to OutRects (Max exclusive) */
+	int32 MergeCellRects(EKernelCellType CellType, TArray<FIntRect>& OutRects) const;
+
+	/* Number of cells in the rectangle that are not the free type, O(1) (rectangle must be inside the grid) */
+	int32 CountBlockedCells(FIntPoint StartCoord, FIntPoint Size) const;
+
+	/* True if the whole rectangle is inside the grid and every cell is RequiredType */
+	bool IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size, EKernelCellType RequiredType) const;
+
+	/* Set every cell in the rectangle (clipped to the grid) to CellType */
+	void MarkArea(FIntPoint StartCoord, FIntPoint Size, EKernelCellType CellType);
+
+	/* MarkArea if IsAreaAvailable */
+	bool TryPlaceArea(FIntPoint StartCoord, FIntPoint Size, EKernelCellType RequiredType, EKernelCellType PlacedType);
+#pragma endregion
+
+#pragma region Fill Algorithms
+	/* Place TargetSize tiles (either orientation) at every AvailableType origin, scanning row by row
+	 * @param Stream - Drives tile and rotation picks (same stream state = same placements)
+	 * @return Number of tiles placed (appended to OutPlacements) */
+	int32 FillWithTileSize(const FKernelTilePool& TilePool, FIntPoint TargetSize, EKernelCellType AvailableType,
+	EKernelCellType PlacedType, FRandomStream& Stream, TKernelScratchArray<FKernelTilePlacement>& OutPlacements);
+
+	/* Fill leftover AvailableType cells with the gap-fill sizes (1x4, 4x1, 1x2, 2x1, 1x1) */
+	int32 FillRemainingGaps(const FKernelTilePool& TilePool, EKernelCellType AvailableType, EKernelCellType PlacedType,
+	FRandomStream& Stream, TKernelScratchArray<FKernelTilePlacement>& OutPlacements);
+
+	/* True if some free-type rectangle of Size is left (index rebuilt first if stale) */
+	bool CanFitFreeArea(FIntPoint Size);
+
+	/* Pack a straight run of RunLength cells with the fewest wall modules (coin-change DP over each open stretch)
+	 * Covered cells are maximised first, then module count minimised, larger footprints lead on ties.
+	 * @param IsCellBlocked - Returns true for run cells that must stay open (doorways, forced walls)
+	 * @param Stream - Picks the module within each footprint by PlacementWeight */
+	static void PackWallRun(int32 RunLength, const FKernelWallModuleTable& Modules, TFunctionRef<bool(int32)> IsCellBlocked,
+	FRandomStream& Stream, TKernelScratchArray<FKernelWallSpan>& OutSpans);
+#pragma endregion
+
+#pragma region Descriptor Helpers
+	/* Footprint after a yaw rotation (90/270 swap X and Y) */
+	static FIntPoint GetRotatedFootprint(FIntPoint Footprint, int32 Rotation);
+
+	/* Convert a list of yaw angles into a quarter-turn mask (non multiples of 90 are ignored) */
+	static uint8 MakeRotationMask(const TArray<int32>& Rotations);
+
+	/* Pick a random allowed rotation whose footprint equals TargetSize (0 if none) */
+	static int32 PickRotationForSize(const FKernelTileDesc& Tile, FIntPoint TargetSize, FRandomStream& Stream);
+
+#pragma endregion
+
+private:
+#pragma region Bitboards
+	static constexpr int32 NumCellTypes = static_cast<int32>(EKernelCellType::ECT_Void) + 1;
+
+	uint64* GetTypeRow(EKernelCellType CellType, int32 Y)
+	{ return TypeBits.GetData() + (static_cast<int32>(CellType) * GridSize.Y + Y) * WordsPerRow; }
+
+	const uint64* GetTypeRow(EKernelCellType CellType, int32 Y) const
+	{ return TypeBits.GetData() + (static_cast<int32>(CellType) * GridSize.Y + Y) * WordsPerRow; }
+
+	/* Recompute every bitboard from Cells */
+	void RebuildTypeBits();
+
+	/* Bits [MinX, MaxX) of a row */
+	static bool AreRowBitsSet(const uint64* Row, int32 MinX, int32 MaxX);
+	static void SetRowBits(uint64* Row, int32 MinX, int32 MaxX);
+	static void ClearRowBits(uint64* Row, int32 MinX, int32 MaxX);
+	static int32 CountRowBits(const uint64* Row, int32 MinX, int32 MaxX);
+#pragma endregion
+
+#pragma region Summed-Area Table
+	int32 GetBlockedSum(int32 X, int32 Y) const { return BlockedSums[Y * (GridSize.X + 1) + X]; }
+
+	/* Recompute the whole table from Cells */
+	void RebuildBlockedSums() const;
+
+	/* Rebuild the table if cells changed since it was last valid (edits only mark it dirty, queries pay once per batch) */
+	void EnsureBlockedSums() const { if (bBlockedSumsDirty) RebuildBlockedSums(); }
+#pragma endregion
+
+#pragma region Free Rectangle Index
+	/* Rebuild the index if cells were freed since it was last valid */
+	void EnsureFreeRects();
+
+	/* Remove Used from every free rectangle it overlaps (MaxRects split + containment prune) */
+	void SplitFreeRects(const FIntRect& Used);
+
+	/* First free origin for Size at or after From in row-major (Y, then X) order */
+	bool FindNextFreeOrigin(FIntPoint Size, FIntPoint From, FIntPoint& OutOrigin) const;
+#pragma endregion
+
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+	TArray<EKernelCellType> Cells;
+
+	/* [CellType][Row][Word] occupancy bits, one bit per cell */
+	TArray<uint64> TypeBits;
+	int32 WordsPerRow = 0;
+
+	/* (GridSize.X + 1) x (GridSize.Y + 1) prefix sums, entry (X, Y) = cells != FreeType in [0, X) x [0, Y)
+	 * Rebuilt lazily from const queries, so a kernel must not be queried and edited from different threads at once */
+	mutable TArray<int32> BlockedSums;
+	mutable bool bBlockedSumsDirty = true;
+	EKernelCellType FreeType = EKernelCellType::ECT_Empty;
+
+	/* Maximal rectangles of free-type cells (Max exclusive), only valid while !bFreeRectsDirty */
+	TArray<FIntRect> FreeRects;
+	bool bFreeRectsDirty = true;
+};
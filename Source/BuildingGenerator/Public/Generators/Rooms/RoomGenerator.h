@@ -3,20 +3,56 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
 #include "Data/Grid/GridData.h"
 #include "Data/Room/FloorData.h"
 #include "Data/Room/WallData.h"
 #include "Data/Room/DoorData.h"
 #include "Data/Room/CeilingData.h"
 #include "Data/Room/RoomData.h"
+#include "Generators/Rooms/Kernel/RoomGenerationKernel.h"
+#include "Generators/Rooms/RoomStageGraph.h"
 #include "RoomGenerator.generated.h"
 
+#pragma region Kernel Cell Conversion
+/* The kernel keeps its own cell enum so it only depends on Core; both enums must stay value-identical */
+static_assert(static_cast<uint8>(EGridCellType::ECT_Empty) == static_cast<uint8>(EKernelCellType::ECT_Empty), "EKernelCellType out of sync with EGridCellType");
+static_assert(static_cast<uint8>(EGridCellType::ECT_FloorMesh) == static_cast<uint8>(EKernelCellType::ECT_FloorMesh), "EKernelCellType out of sync with EGridCellType");
+static_assert(static_cast<uint8>(EGridCellType::ECT_WallMesh) == static_cast<uint8>(EKernelCellType::ECT_WallMesh), "EKernelCellType out of sync with EGridCellType");
+static_assert(static_cast<uint8>(EGridCellType::ECT_Doorway) == static_cast<uint8>(EKernelCellType::ECT_Doorway), "EKernelCellType out of sync with EGridCellType");
+static_assert(static_cast<uint8>(EGridCellType::ECT_Reserved) == static_cast<uint8>(EKernelCellType::ECT_Reserved), "EKernelCellType out of sync with EGridCellType");
+static_assert(static_cast<uint8>(EGridCellType::ECT_Custom) == static_cast<uint8>(EKernelCellType::ECT_Custom), "EKernelCellType out of sync with EGridCellType");
+static_assert(static_cast<uint8>(EGridCellType::ECT_Void) == static_cast<uint8>(EKernelCellType::ECT_Void), "EKernelCellType out of sync with EGridCellType");
+
+FORCEINLINE EKernelCellType ToKernelCell(EGridCellType CellType) { return static_cast<EKernelCellType>(CellType); }
+FORCEINLINE EGridCellType ToGridCell(EKernelCellType CellType) { return static_cast<EGridCellType>(CellType); }
+#pragma endregion
+
 
 
 struct FPlacedMeshInfo;
 struct FGeneratorWallSegment;
 struct FPlacedCeilingInfo;
 
+/* Generation stages with their own random stream (streams are derived from the room seed, so regenerating one stage
+ * never shifts the random sequence of another) */
+enum class ERoomRandomStage : uint32
+{
+	Layout,
+	Floor,
+	Walls,
+	Doorways,
+	Ceiling
+};
+
+/* One mesh instance published by a stage while placement streaming is on (room-local transform) */
+struct FRoomStreamedPlacement
+{
+	ERoomMeshCategory Category = ERoomMeshCategory::Floor;
+	TSoftObjectPtr<UStaticMesh> Mesh;
+	FTransform Transform;
+};
+
 /* RoomGenerator - Pure logic class for room generation Handles grid creation, mesh placement algorithms, and room data processing */
 UCLASS(Abstract)
 class BUILDINGGENERATOR_API URoomGenerator : public UObject
@@ -33,15 +69,37 @@ protected:
 	
 public:
 #pragma region Initialization
-	/* Initialize the room generator with room data */
-	bool Initialize(URoomData* InRoomData, FIntPoint InGridSize);
+	/* Initialize the room generator with room data
+	 * @param InRoomSeed - Seed for every generation stage (-1 = pick a random seed) */
+	bool Initialize(URoomData* InRoomData, FIntPoint InGridSize, int32 InRoomSeed = -1);
 	UFUNCTION(BlueprintPure, Category = "Room Generator")
 	bool IsInitialized() const { return bIsInitialized; }
 #pragma endregion
+
+#pragma region Random Streams
+	/* Seed actually used (resolved from -1 during Initialize), same seed + same data = same room */
+	int32 GetRoomSeed() const { return RoomSeed; }
+
+	/* Change the seed (takes effect at the next BeginRandomStage) */
+	void SetRoomSeed(int32 InRoomSeed) { RoomSeed = InRoomSeed; }
+
+	/* Stream for a stage, derived from RoomSeed */
+	FRandomStream MakeStageStream(ERoomRandomStage Stage) const;
+
+	/* Reseed the stream of Stage and return it (called at the top of each Generate*, which passes the stream down to
+	 * every helper it draws from, so stages running concurrently never share a stream) */
+	FRandomStream& BeginRandomStage(ERoomRandomStage Stage);
+#pragma endregion
+
+#pragma region Stage Graph
+	/* Declare the generation stages (Floor, Walls, Corners, Doorways, Ceiling) with the state each reads and writes
+	 * Subclasses narrow the access sets where their stages touch less, which lets more of them run concurrently */
+	virtual void BuildStageGraph(FRoomStageGraph& Graph) const;
+#pragma endregion
 	
 #pragma region public Internal Floor Generation Functions
 	/* Select a mesh from pool using weighted random selection */
-	FMeshPlacementInfo SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool);
+	FMeshPlacementInfo SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool, FRandomStream& Stream);
 	
 	/* Calculate footprint size in cells from mesh bounds */
 	FIntPoint CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const;
@@ -55,17 +113,16 @@ public:
 	// Grid dimensions in cells
 	FIntPoint GridSize;
 	
-	// Grid state array (row-major order: Index = Y * GridSize.X + X)
-	UPROPERTY()
-	TArray<EGridCellType> GridState;
+	// Grid state and fill algorithms (row-major order: Index = Y * GridSize.X + X)
+	FRoomGenerationKernel GridKernel;
 	
 	UFUNCTION(BlueprintCallable, Category = "Room Generator")
 	virtual void CreateGrid() PURE_VIRTUAL(URoomGenerator::CreateGrid, );
 	UFUNCTION(BlueprintCallable, Category = "Room Generator")
-	void ClearGrid();
+	virtual void ClearGrid();
 	UFUNCTION(BlueprintCallable, Category = "Room Generator")
 	void ResetGridCellStates();
-	const TArray<EGridCellType>& GetGridState() const { return GridState; }
+	TArray<EGridCellType> GetGridState() const;
 	FIntPoint GetGridSize() const { return GridSize; }
 	float GetCellSize() const { return CellSize; }
 	EGridCellType GetCellState(FIntPoint GridCoord) const;
@@ -102,17 +159,20 @@ public:
 	 * Places designer-specified meshes at exact coordinates before random fill */
 	int32 ExecuteForcedPlacements();
 
-	/* Fill remaining empty cells with meshes from the pool */
-	int32 FillRemainingGaps(const TArray<FMeshPlacementInfo>& TilePool, int32& OutLargeTiles,
-	int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles); 
+	/* Fill remaining empty cells with meshes from the pool (CompiledPool = TilePool compiled by its style asset) */
+	int32 FillRemainingGaps(const TArray<FMeshPlacementInfo>& TilePool, const FKernelTilePool& CompiledPool, FRandomStream& Stream,
+	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles); 
 	
+	/* Forced empty region as a grid rectangle (any corner order, clamped to the grid, Max exclusive) */
+	FIntRect GetForcedEmptyRegionRect(const FForcedEmptyRegion& Region) const;
+
 	/**
-	 * Expand forced empty regions into individual cell list
+	 * Expand forced empty regions into individual cell list (debugging/inspection only)
 	 * Combines rectangular regions and individual cells into unified list */
 	TArray<FIntPoint> ExpandForcedEmptyRegions() const;
 
-	/* Mark forced empty cells as reserved (blocked from placement) */
-	void MarkForcedEmptyCells(const TArray<FIntPoint>& EmptyCells);
+	/* Mark forced empty regions (row spans) and cells as reserved, returns number of cells newly reserved */
+	int32 MarkForcedEmptyRegions();
 #pragma endregion
 
 #pragma region Wall Generation
@@ -128,16 +188,20 @@ public:
 
 	int32 ExecuteForcedWallPlacements();
 
+	/* Check if any base wall segment on Edge covers [StartCell, StartCell + Length) (occupancy bitset lookup) */
 	bool IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const;
+
+	/* Track a base wall segment for Middle/Top spawning and mark its cells occupied on its edge */
+	void AddBaseWallSegment(const FGeneratorWallSegment& Segment);
+
+	/* Drop tracked base wall segments and their occupancy */
+	void ResetBaseWallSegments();
 	
 	/* Clear all placed walls */
 	void ClearPlacedWalls();
 
-	/* Called after base walls are placed */
-	void SpawnMiddleWallLayers();
-
-	/* Called after middle walls are placed */
-	void SpawnTopWallLayer();
+	/* Called after base walls are placed, stacks Middle1/Middle2/Top on each segment in one pass */
+	void StackWallLayers();
 
 #pragma endregion
 	
@@ -169,6 +233,9 @@ public:
 	/* Check if a cell is part of any doorway */
 	bool IsCellPartOfDoorway(FIntPoint Cell) const;
 
+	/* Check if the CellIndex-th cell along Edge is part of a doorway (bitmask lookup) */
+	bool IsEdgeCellDoorway(EWallEdge Edge, int32 CellIndex) const;
+
 	/* Get list of placed doorways */
 	const TArray<FPlacedDoorwayInfo>& GetPlacedDoorways() const { return PlacedDoorwayMeshes; }
 
@@ -191,7 +258,34 @@ public:
 	const TArray<FPlacedCeilingInfo>& GetPlacedCeilingTiles() const { return PlacedCeilingTiles; }
 
 	/* Clear ceiling data */
-	void ClearPlacedCeiling() { PlacedCeilingTiles.Empty(); }
+	void ClearPlacedCeiling() { PlacedCeilingTiles.Empty(); CeilingKernel.Empty(); }
+#pragma endregion
+
+#pragma region Placement Palettes
+	/* Meshes referenced by floor and ceiling records (FPlacedMeshInfo::MeshIndex) */
+	const TArray<TSoftObjectPtr<UStaticMesh>>& GetPlacedMeshPalette() const { return PlacedMeshPalette; }
+
+	/* Wall modules referenced by wall records (FPlacedWallInfo::ModuleIndex) */
+	const TArray<FWallModule>& GetPlacedWallModulePalette() const { return PlacedWallModulePalette; }
+
+	/* Mesh of a floor or ceiling record (nullptr if the index is out of range) */
+	const TSoftObjectPtr<UStaticMesh>* FindPlacedMesh(const FPlacedMeshInfo& Placed) const;
+
+	/* Module of a wall record (nullptr if the index is out of range) */
+	const FWallModule* FindPlacedWallModule(const FPlacedWallInfo& Placed) const;
+
+	/* Local transform of a floor tile */
+	FTransform GetFloorTileTransform(const FPlacedMeshInfo& Placed) const;
+
+	/* Local transform of a ceiling tile (height and base rotation from CeilingData) */
+	FTransform GetCeilingTileTransform(const FPlacedCeilingInfo& Placed) const;
+
+	/* Local transform of a floor tile record, without a generator (e.g. from an FRoomBatchResult) */
+	static FTransform MakeFloorTileTransform(const FPlacedMeshInfo& Placed, float CellSize);
+
+	/* Local transform of a ceiling tile record, without a generator (e.g. from an FRoomBatchResult) */
+	static FTransform MakeCeilingTileTransform(const FPlacedCeilingInfo& Placed, float CellSize,
+		const FRotator& CeilingRotation, float CeilingHeight);
 #pragma endregion
 	
 #pragma region Coordinate Conversion
@@ -217,6 +311,29 @@ public:
 	int32 GetTotalCellCount() const { return GridSize.X * GridSize.Y; }
 #pragma endregion
 
+#pragma region Collision Proxies
+	/**
+	 * Merged collision boxes in room space, in place of per-instance collision
+	 * Floor cells become greedy rectangles (FloorThickness deep below Z = 0), touching base wall segments on the same
+	 * wall line become one box per straight run (WallThickness deep, WallData->WallHeight tall) and ceiling cells become
+	 * greedy rectangles FloorThickness deep above CeilingData->CeilingHeight.
+	 * @return Number of boxes appended to OutBoxes */
+	int32 BuildCollisionBoxes(float FloorThickness, float WallThickness, TArray<FBox>& OutBoxes) const;
+#pragma endregion
+
+#pragma region Placement Streaming
+	/* Also publish every floor, wall, corner and ceiling mesh to the placement queue as soon as it is recorded,
+	 * so a consumer can spawn while the stages are still running (placement arrays are filled as before) */
+	void SetPlacementStreaming(bool bEnable) { bStreamPlacements = bEnable; }
+	bool IsStreamingPlacements() const { return bStreamPlacements; }
+
+	/* Pop the oldest published placement (single consumer, safe while the stages run on other threads) */
+	bool DequeuePlacement(FRoomStreamedPlacement& OutPlacement) { return PlacementQueue.Dequeue(OutPlacement); }
+
+	/* True when nothing is waiting in the placement queue */
+	bool IsPlacementQueueEmpty() const { return PlacementQueue.IsEmpty(); }
+#pragma endregion
+
 #pragma region Internal Data
 
 	// Reference to room configuration data
@@ -225,6 +342,10 @@ public:
 	
 	// Cell size in cm (from CELL_SIZE constant)
 	float CellSize;
+
+	// Room seed and one stream per random stage (per instance, so stages can run concurrently, see BeginRandomStage)
+	int32 RoomSeed = 0;
+	FRandomStream StageStreams[static_cast<int32>(ERoomRandomStage::Ceiling) + 1];
 	
 	// Placed floor meshes
 	UPROPERTY()
@@ -245,10 +366,31 @@ public:
 	// Placed doorways
 	UPROPERTY()
 	TArray<FPlacedDoorwayInfo> PlacedDoorwayMeshes;
+
+	// Doorway cells per edge (indexed by EWallEdge - 1, bit = cell index along the edge), rebuilt by MarkDoorwayCells
+	TBitArray<> DoorwayEdgeBits[4];
+
+	// Cells covered by base wall segments per edge (indexed by EWallEdge - 1), kept in step with PlacedBaseWallSegments
+	TBitArray<> WallOccupancyBits[4];
 	
 	/* Placed ceiling tiles (output of GenerateCeiling) */
 	UPROPERTY()
 	TArray<FPlacedCeilingInfo> PlacedCeilingTiles;
+
+	// Palettes behind the compact records, one entry per distinct mesh/module (mesh palette lives until ClearGrid)
+	UPROPERTY()
+	TArray<TSoftObjectPtr<UStaticMesh>> PlacedMeshPalette;
+	TMap<TSoftObjectPtr<UStaticMesh>, int32> MeshPaletteLookup;
+
+	// Floor and ceiling stages may add to the mesh palette at the same time
+	FCriticalSection MeshPaletteLock;
+
+	UPROPERTY()
+	TArray<FWallModule> PlacedWallModulePalette;
+	TMap<const FWallModule*, int32> WallModulePaletteLookup;
+
+	int32 AddToMeshPalette(const TSoftObjectPtr<UStaticMesh>& Mesh);
+	int32 AddToWallModulePalette(const FWallModule& Module);
 	
 	// Statistics tracking
 	int32 LargeTilesPlaced;
@@ -262,23 +404,46 @@ public:
 
 	// Helper to calculate transforms from layout
 	FPlacedDoorwayInfo CalculateDoorwayTransforms(const FDoorwayLayoutInfo& Layout);
+
+	// Ceiling occupancy (ECT_Empty = open, ECT_FloorMesh = covered)
+	FRoomGenerationKernel CeilingKernel;
+
+	// Placements published while streaming (concurrent stages produce, the spawner consumes)
+	TQueue<FRoomStreamedPlacement, EQueueMode::Mpsc> PlacementQueue;
+	bool bStreamPlacements = false;
+
+	/* Enqueue one mesh instance if placement streaming is on */
+	void PublishPlacement(ERoomMeshCategory Category, const TSoftObjectPtr<UStaticMesh>& Mesh, const FTransform& Transform);
+
+	/* Publish every layer of a stacked wall (same layers URoomSpawnerHelpers::AddWallSegmentToBatches spawns) */
+	void PublishWallPlacement(const FPlacedWallInfo& PlacedWall, const FWallModule& Module);
 #pragma endregion
 
 #pragma region private Internal Floor Generation Functions
 	/* Fill grid with tiles of specific size */
-	void FillWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, FIntPoint TargetSize, 
-	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+	void FillWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, const FKernelTilePool& CompiledPool, FIntPoint TargetSize,
+	FRandomStream& Stream, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+
+	/* Store a floor placement (grid cells must already be marked) */
+	void RecordFloorPlacement(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation);
+
+	/* Bump Large/Medium/Small/Filler counters by tile area */
+	static void AddTileStatistics(FIntPoint TileSize, int32 Count, int32& OutLargeTiles, int32& OutMediumTiles,
+	int32& OutSmallTiles, int32& OutFillerTiles);
 #pragma endregion
 
 #pragma region Internal Ceiling Generation Functions
-	// Ceiling generation helpers
-	void FillCeilingWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, TArray<bool>& CeilingOccupied, 
-	FIntPoint TargetSize, const FRotator& CeilingRotation, float CeilingHeight, int32& OutTilesPlaced);
+	// Ceiling generation helpers (operate on CeilingKernel)
+	void FillCeilingWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, const FKernelTilePool& CompiledPool, FIntPoint TargetSize,
+	FRandomStream& Stream, int32& OutTilesPlaced);
+
+	int32 FillRemainingCeilingGaps(const TArray<FMeshPlacementInfo>& TilePool, const FKernelTilePool& CompiledPool,
+	FRandomStream& Stream, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
 
-	int32 FillRemainingCeilingGaps(const TArray<FMeshPlacementInfo>& TilePool, TArray<bool>& CeilingOccupied, const FRotator& CeilingRotation,
-	float CeilingHeight, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+	int32 ExecuteForcedCeilingPlacements();
 
-	int32 ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupied);
+	/* Store a ceiling placement (ceiling cells must already be marked) */
+	void RecordCeilingPlacement(FIntPoint GridCoordinate, FIntPoint TileSize, const FMeshPlacementInfo& TileInfo, int32 Rotation);
 #pragma endregion
 	
 #pragma region Internal Helpers
@@ -289,7 +454,7 @@ public:
 	FIntPoint IndexToGridCoord(int32 Index) const;
 
 	/* Fill one edge with wall modules using greedy bin packing */
-	void FillWallEdge(EWallEdge Edge);
+	void FillWallEdge(EWallEdge Edge, FRandomStream& Stream);
 #pragma endregion
 	
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class URoomGenerator;
+
+/* Generator state a stage reads or writes (two stages conflict when one writes what the other reads or writes) */
+enum class ERoomStageAccess : uint32
+{
+	None              = 0,
+	GridCells         = 1 << 0,  // GridKernel cell types
+	FloorPlacements   = 1 << 1,  // Placed floor meshes
+	WallPlacements    = 1 << 2,  // Placed walls, base segments, wall occupancy, wall module palette, WallData, chunky perimeter masks
+	CornerPlacements  = 1 << 3,  // Placed corners (and the chunky corner cell bits)
+	DoorwayLayout     = 1 << 4,  // Doorway layouts, placed doorways, doorway edge bits, DoorData
+	CeilingPlacements = 1 << 5   // CeilingKernel, placed ceiling tiles, CeilingData
+};
+ENUM_CLASS_FLAGS(ERoomStageAccess)
+
+/* One generation stage, what it touches and how to run it */
+struct FRoomStageNode
+{
+	FName Name;
+	ERoomStageAccess Reads = ERoomStageAccess::None;
+	ERoomStageAccess Writes = ERoomStageAccess::None;
+
+	/* A failed required stage fails the room, stages that have not started yet are skipped */
+	bool bRequired = false;
+
+	TFunction<bool(URoomGenerator&)> Run;
+};
+
+/**
+ * RoomStageGraph - The generation stages of one room as a dependency graph
+ * Stages are declared in their serial order and depend on every earlier stage they conflict with, so the result is
+ * the same as running them one after another while stages without conflicts (e.g. ceiling and walls) run
+ * concurrently on the task graph. Bookkeeping every stage shares (random streams, mesh palette, placement queue)
+ * is safe to use concurrently and is not part of the access sets. */
+class BUILDINGGENERATOR_API FRoomStageGraph
+{
+public:
+	/* Append a stage after the ones already declared @return Stage index */
+	int32 AddStage(FName Name, ERoomStageAccess Reads, ERoomStageAccess Writes, bool bRequired, TFunction<bool(URoomGenerator&)> Run);
+
+	/* Declared stage by name (for generators that refine a stage's access sets), nullptr if not declared */
+	FRoomStageNode* FindStage(FName Name);
+
+	/* Earlier stages Stage has to wait for */
+	void GetPrerequisites(int32 Stage, TArray<int32>& OutPrerequisites) const;
+
+	/* Launch every stage on the task graph and wait for all of them (the generator's grid must already exist)
+	 * @return False if a required stage failed */
+	bool Execute(URoomGenerator& Generator) const;
+
+	const TArray<FRoomStageNode>& GetStages() const { return Stages; }
+
+private:
+	TArray<FRoomStageNode> Stages;
+};
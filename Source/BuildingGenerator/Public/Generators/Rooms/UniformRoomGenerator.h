@@ -23,6 +23,8 @@ public:
 	virtual bool GenerateDoorways() override;
 	virtual bool GenerateCeiling() override;
 
+	virtual void BuildStageGraph(FRoomStageGraph& Graph) const override;
+
 private:
 	// Private helper methods will be moved here as needed
 };
@@ -11,6 +11,7 @@
 class UBoxComponent;
 class UStaticMeshComponent;
 class USceneComponent;
+struct FStreamableHandle;
 
 /**
  * ADoorwayActor - Interactive doorway with frame and side fills
@@ -163,4 +164,8 @@ public:
     // ========================================================================
 
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+private:
+    /* Door meshes streamed for a doorway whose room didn't stream them (e.g. one placed by hand) */
+    TSharedPtr<FStreamableHandle> DoorMeshHandle;
 };
\ No newline at end of file
@@ -0,0 +1,132 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "BuildingInstancePool.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/* Where one pooled instance came from (range handle, mesh entry of that range, slot in the entry) */
+struct FBuildingInstanceOwner
+{
+	int32 Range = INDEX_NONE;
+	int32 Entry = INDEX_NONE;
+	int32 Slot = INDEX_NONE;
+};
+
+/* Instances one range placed into one mesh pool (indices move when other ranges are removed) */
+struct FBuildingRangeEntry
+{
+	int32 MeshPool = INDEX_NONE;
+	TArray<int32> Instances;
+
+	/* Pool-space transforms of the instances while the range is hidden (they are removed from the component meanwhile) */
+	TArray<FTransform> HiddenTransforms;
+};
+
+/* Everything one submission (e.g. the floor of one room) added to the pool */
+struct FBuildingInstanceRange
+{
+	TArray<FBuildingRangeEntry> Entries;
+
+	/* Range space to pool owner space at submit time (instances are stored baked with it) */
+	FTransform RangeToPool;
+	bool bHidden = false;
+};
+
+/* One shared instanced component and the owner of each of its instances (index == instance index) */
+USTRUCT()
+struct FBuildingMeshPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Component = nullptr;
+
+	TArray<FBuildingInstanceOwner> Owners;
+};
+
+/**
+ * BuildingInstancePool - One (H)ISM component per unique mesh (and collision setting) for a whole building
+ * Rooms submit their per-mesh transform batches as ranges and get a handle back. Removing a range fills its slots
+ * with instances from the end of each component (swap-remove), so no other instance has to be rebuilt. */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class BUILDINGGENERATOR_API UBuildingInstancePool : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UBuildingInstancePool();
+
+	/* Create hierarchical (HISM) components instead of plain ISM components */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instance Pool")
+	bool bUseHierarchicalInstances = true;
+
+#pragma region Instance Ranges
+	/* Add per-mesh batches (local to RangeTransform, e.g. the room actor transform) as a new range
+	 * @param bInstanceCollision - Place the instances in components with per-instance collision bodies
+	 * (off: the submitter provides merged collision proxies) @return Range handle, INDEX_NONE if nothing was added */
+	int32 AddInstanceRange(const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches, const FTransform& RangeTransform,
+	bool bInstanceCollision = false);
+
+	/* Swap-remove every instance of a range, returns false for unknown handles */
+	bool RemoveInstanceRange(int32 RangeHandle);
+
+	/* Remove RangeHandle (if valid) and add the batches as its replacement, RangeHandle is updated
+	 * @return Number of instances added */
+	int32 ReplaceInstanceRange(int32& RangeHandle, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+	const FTransform& RangeTransform, bool bInstanceCollision = false);
+
+	/* Move a range whose submitter moved: re-bakes every instance from the old RangeTransform to the new one
+	 * @return False for unknown handles */
+	bool SetInstanceRangeTransform(int32 RangeHandle, const FTransform& RangeTransform);
+
+	/* Hide or show a range (shared components can't hide single instances, so a hidden range's instances are removed
+	 * and re-added when shown; handles stay valid, instance indices don't) @return False for unknown handles */
+	bool SetInstanceRangeHidden(int32 RangeHandle, bool bHidden);
+
+	/* Number of instances a range currently owns (0 while hidden) */
+	int32 GetRangeInstanceCount(int32 RangeHandle) const;
+
+	/* Destroy every pooled component and forget all ranges */
+	void ClearPool();
+#pragma endregion
+
+#pragma region Statistics
+	/* Number of shared components (one per unique mesh and collision setting) */
+	int32 GetNumComponents() const { return MeshPools.Num(); }
+
+	/* Number of registered ranges */
+	int32 GetNumRanges() const { return Ranges.Num(); }
+
+	/* Total instances across all components */
+	int32 GetTotalInstanceCount() const;
+#pragma endregion
+
+protected:
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
+private:
+	/* Add PoolTransforms to the entry's component and record the range as their owner (the entry must own no instances) */
+	void AddEntryInstances(int32 RangeHandle, int32 EntryIndex, const TArray<FTransform>& PoolTransforms);
+
+	/* Swap-remove every instance of an entry from its component */
+	void RemoveEntryInstances(FBuildingRangeEntry& Entry);
+
+	/* Component index for a mesh and collision setting, created (and attached to the owner's root) on first use,
+	 * INDEX_NONE if the mesh is invalid */
+	int32 GetOrCreateMeshPool(const TSoftObjectPtr<UStaticMesh>& MeshAsset, bool bInstanceCollision);
+
+	/* Shared components, indexed by FBuildingRangeEntry::MeshPool */
+	UPROPERTY()
+	TArray<FBuildingMeshPool> MeshPools;
+
+	/* (Mesh, has instance collision) -> MeshPools index */
+	TMap<TPair<TSoftObjectPtr<UStaticMesh>, bool>, int32> MeshPoolLookup;
+
+	/* Registered ranges, the sparse index is the range handle */
+	TSparseArray<FBuildingInstanceRange> Ranges;
+};
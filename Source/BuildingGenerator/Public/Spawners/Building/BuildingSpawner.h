@@ -6,6 +6,18 @@
 #include "GameFramework/Actor.h"
 #include "BuildingSpawner.generated.h"
 
+class ARoomSpawner;
+class UBuildingInstancePool;
+
+/* Doorway shared by two rooms, as its opening segment in world XY */
+struct FBuildingPortal
+{
+	int32 RoomA = INDEX_NONE;
+	int32 RoomB = INDEX_NONE;
+	FVector2D Start = FVector2D::ZeroVector;
+	FVector2D End = FVector2D::ZeroVector;
+};
+
 UCLASS()
 class BUILDINGGENERATOR_API ABuildingSpawner : public AActor
 {
@@ -15,6 +27,41 @@ public:
 	// Sets default values for this actor's properties
 	ABuildingSpawner();
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	USceneComponent* SceneRoot;
+
+	/* Shared (H)ISM components for every room of this building (one per unique mesh) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UBuildingInstancePool* InstancePool;
+
+	/* Get the building-wide instance pool */
+	UBuildingInstancePool* GetInstancePool() const { return InstancePool; }
+
+#pragma region Portal Culling
+	/* Hide rooms the camera can't see through the chain of doorways from the room it is in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Portal Culling")
+	bool bEnablePortalCulling = true;
+
+	/* Deepest portal chain followed from the camera room */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Portal Culling", meta = (ClampMin = "1"))
+	int32 MaxPortalDepth = 16;
+
+	/* Two doorways are the same portal when their opening centers are closer than this (world units) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Portal Culling", meta = (ClampMin = "0.0"))
+	float PortalMatchTolerance = 50.0f;
+
+	/* Rebuild the room/portal graph on the next tick (rooms call this when their doorways change) */
+	void MarkPortalGraphDirty() { bPortalGraphDirty = true; }
+
+	/* Gather the generated rooms of this building and link doorways that coincide into portals */
+	UFUNCTION(BlueprintCallable, Category = "Portal Culling")
+	void RebuildPortalGraph();
+
+	/* Show the rooms reachable through the camera's portal chain and hide the rest */
+	UFUNCTION(BlueprintCallable, Category = "Portal Culling")
+	void UpdatePortalVisibility();
+#pragma endregion
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -22,4 +69,26 @@ protected:
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
+
+private:
+#pragma region Portal Culling
+	/* Narrow the view window [MinAngle, MaxAngle] (radians from the view direction) through every portal of RoomIndex
+	 * and mark the rooms behind the portals that stay open */
+	void FlowThroughPortals(int32 RoomIndex, const FVector2D& ViewOrigin, const FVector2D& ViewDirection, double MinAngle,
+	double MaxAngle, int32 Depth, TBitArray<>& OutVisible, TBitArray<>& OnPath) const;
+
+	/* Show every tracked room (culling disabled or graph rebuilt) */
+	void ShowAllRooms();
+
+	/* Rooms with OwningBuilding == this, indexed by FBuildingPortal::RoomA/RoomB */
+	TArray<TWeakObjectPtr<ARoomSpawner>> PortalRooms;
+
+	TArray<FBuildingPortal> Portals;
+
+	/* Portal indices per room */
+	TArray<TArray<int32>> RoomPortals;
+
+	bool bPortalGraphDirty = true;
+	bool bRoomsCulled = false;
+#pragma endregion
 };
@@ -0,0 +1,139 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Tasks/Task.h"
+#include "UObject/Object.h"
+#include "Spawners/Rooms/RoomSpawner.h"
+#include "RoomGenerationJob.generated.h"
+
+struct FStreamableHandle;
+class UStaticMesh;
+
+/* Steps of a time-sliced room generation, in execution order */
+UENUM(BlueprintType)
+enum class ERoomGenerationPhase : uint8
+{
+	LoadingStyles,
+	LoadingMeshes,
+	Grid,
+	StreamingStages,
+	Floor,
+	Walls,
+	Corners,
+	Doorways,
+	Ceiling,
+	SpawningMeshes,
+	SpawningDoorways,
+	Finished,
+	Failed,
+	Cancelled
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRoomGenerationProgress, URoomGenerationJob*, Job, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRoomGenerationFinished, URoomGenerationJob*, Job, bool, bSucceeded);
+
+/**
+ * RoomGenerationJob - Generates and spawns one room at runtime without a frame spike
+ * Streams the room assets asynchronously, then runs the generator stages and ISM population as small steps and
+ * only takes new steps while the frame's BudgetMs is left. A stage always runs to completion once started, so the
+ * budget is a target rather than a hard limit; instance population is split into InstancesPerStep chunks.
+ * With bOverlapSpawning the stages run on workers instead (URoomGenerator::BuildStageGraph, independent stages
+ * concurrently) and publish their placements as they decide them, the job spawns those while the stages still run. */
+UCLASS(BlueprintType)
+class BUILDINGGENERATOR_API URoomGenerationJob : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/* Milliseconds of game thread time one frame may spend on this job */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Runtime", meta = (ClampMin = "0.1"))
+	float BudgetMs = 2.0f;
+
+	/* Instances added per step when the room owns its ISM components (pooled rooms submit one category per step) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Runtime", meta = (ClampMin = "1"))
+	int32 InstancesPerStep = 256;
+
+	/* Run the stages on a worker and spawn placements as they are published (rooms with their own ISM components only,
+	 * pooled rooms replace whole ranges and run the stages step by step) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Runtime")
+	bool bOverlapSpawning = true;
+
+	/* Broadcast once per frame the job worked, Progress in [0, 1] */
+	UPROPERTY(BlueprintAssignable, Category = "Room Generation|Runtime")
+	FOnRoomGenerationProgress OnProgress;
+
+	/* Broadcast once when the job ends (cancelled jobs report false) */
+	UPROPERTY(BlueprintAssignable, Category = "Room Generation|Runtime")
+	FOnRoomGenerationFinished OnFinished;
+
+	/* Begin generating InRoom, the job ticks itself from the next frame on @return False if InRoom is invalid */
+	bool Start(ARoomSpawner* InRoom);
+
+	/* Stop after the current step, the room keeps what was spawned so far */
+	UFUNCTION(BlueprintCallable, Category = "Room Generation|Runtime")
+	void Cancel();
+
+	UFUNCTION(BlueprintPure, Category = "Room Generation|Runtime")
+	bool IsRunning() const { return Phase < ERoomGenerationPhase::Finished && Room.IsValid(); }
+
+	UFUNCTION(BlueprintPure, Category = "Room Generation|Runtime")
+	ERoomGenerationPhase GetPhase() const { return Phase; }
+
+	/* Fraction of the steps done, in [0, 1] */
+	UFUNCTION(BlueprintPure, Category = "Room Generation|Runtime")
+	float GetProgress() const;
+
+#pragma region FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+#pragma endregion
+
+private:
+	/* Run one step of the current phase @return False when the job has to wait for a later frame (loading, done) */
+	bool Step();
+
+	/* Request Paths asynchronously into Handle @return True if nothing has to be waited for */
+	static bool RequestAssets(TArray<FSoftObjectPath>&& Paths, TSharedPtr<FStreamableHandle>& Handle);
+
+	/* Spawn the next chunk of mesh instances @return False once every category is spawned */
+	bool StepSpawnMeshes();
+
+	/* Run one generator stage (Floor to Ceiling) @return False if a required stage (floor, walls) failed */
+	static bool RunGeneratorStage(URoomGenerator* Generator, ERoomGenerationPhase Stage);
+
+	/* Warm the compiled style caches and execute the generator's stage graph on a worker with placement streaming on */
+	void LaunchStreamingStages(URoomGenerator* Generator);
+
+	/* Spawn up to InstancesPerStep published placements @return False while waiting for the worker */
+	bool StepStreamedPlacements();
+
+	/* End the job in EndPhase and broadcast OnFinished */
+	void Finish(ERoomGenerationPhase EndPhase);
+
+	TWeakObjectPtr<ARoomSpawner> Room;
+	ERoomGenerationPhase Phase = ERoomGenerationPhase::Finished;
+
+	/* Keep the streamed assets resident while the room uses them */
+	TSharedPtr<FStreamableHandle> StyleAssetHandle;
+	TSharedPtr<FStreamableHandle> MeshAssetHandle;
+
+#pragma region Mesh Spawning
+	/* Category being spawned (index into ERoomMeshCategory) */
+	int32 SpawnCategory = 0;
+
+	/* Batches of SpawnCategory flattened per mesh, filled when the category starts */
+	TArray<TPair<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>> CategoryBatches;
+	bool bCategoryGathered = false;
+	int32 BatchIndex = 0;
+	int32 InstanceIndex = 0;
+#pragma endregion
+
+	/* Worker executing the stage graph in StreamingStages (result = required stages succeeded) */
+	UE::Tasks::TTask<bool> StageTask;
+};
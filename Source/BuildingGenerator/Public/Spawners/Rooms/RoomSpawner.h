@@ -10,9 +10,15 @@
 #include "RoomSpawner.generated.h"
 
 class ADoorway;
+class ABuildingSpawner;
+class URoomGenerationJob;
+class UBuildingInstancePool;
+struct FStreamableHandle;
 class UWallData;
 class UTextRenderComponent;
 class UInstancedStaticMeshComponent;
+class UBoxComponent;
+
 /**
  * RoomSpawner - Actor responsible for spawning and visualizing rooms in the level
  * Holds RoomGenerator for logic and DebugHelpers for visualization Provides CallInEditor functions for designer workflow */
@@ -43,6 +49,26 @@ public:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration", meta = (ClampMin = "4", ClampMax = "50"))
 	FIntPoint RoomGridSize = FIntPoint(10, 10);
+
+	/* Seed for every generation stage (-1 = random each time, 0+ = same room every time) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
+	int32 RoomSeed = -1;
+
+	/* Building whose shared instance pool receives this room's meshes (None = this room owns its ISM components) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
+	ABuildingSpawner* OwningBuilding = nullptr;
+#pragma endregion
+
+#pragma region Collision Properties
+	/* Collide through a few merged boxes (floor and ceiling rectangles, straight wall runs) instead of per-instance floor/wall/ceiling bodies */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Collision")
+	bool bUseMergedCollision = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Collision", meta = (ClampMin = "1.0", EditCondition = "bUseMergedCollision"))
+	float CollisionFloorThickness = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Collision", meta = (ClampMin = "1.0", EditCondition = "bUseMergedCollision"))
+	float CollisionWallThickness = 20.0f;
 #pragma endregion
 
 #pragma region Editor Functions
@@ -145,9 +171,60 @@ public:
 	/* Check if room is generated */
 	bool IsRoomGenerated() const { return bIsGenerated; }
 
+	/* Releases this room's ranges from the building instance pool */
+	virtual void Destroyed() override;
+
+#pragma region Visibility
+	/* Show or hide every floor, wall, corner and ceiling instance and the doorway actors of this room (used by portal culling) */
+	void SetRoomMeshesVisible(bool bVisible);
+
+	/* True while the room meshes are shown */
+	bool AreRoomMeshesVisible() const { return bMeshesVisible; }
+
+	/* True if WorldLocation is inside the room volume (grid footprint, floor up to wall height) */
+	bool ContainsWorldPoint(const FVector& WorldLocation) const;
+#pragma endregion
+
+#pragma region Runtime Generation
+	/* Generate the whole room at runtime, spread over frames so each frame spends at most BudgetMs on it
+	 * Restarts (cancelling) a job that is still running @return The job, bind its OnFinished/OnProgress to follow it */
+	UFUNCTION(BlueprintCallable, Category = "Room Generation|Runtime")
+	URoomGenerationJob* StartTimeSlicedGeneration(float BudgetMs = 2.0f);
+
+	/* Job of the last StartTimeSlicedGeneration call (may have finished) */
+	UFUNCTION(BlueprintPure, Category = "Room Generation|Runtime")
+	URoomGenerationJob* GetGenerationJob() const { return GenerationJob; }
+
+	/* Clear every spawned instance (the components are kept), doorway actor and the layout, then create a fresh grid */
+	bool ResetRoomForGeneration();
+
+	/* Group the generator's placements of one category by mesh (room-local transforms) */
+	void GatherMeshBatches(ERoomMeshCategory Category, TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& OutBatches) const;
+
+	/* Replace the category's instances with Batches (own components or building pool) */
+	int32 SubmitCategoryBatches(ERoomMeshCategory Category, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches);
+
+	/* Append instances to the category's component for MeshAsset (own components only, lets a job add them in chunks) */
+	int32 AddMeshInstances(ERoomMeshCategory Category, const TSoftObjectPtr<UStaticMesh>& MeshAsset, const TArray<FTransform>& Transforms);
+
+	/* True when meshes go to OwningBuilding's instance pool instead of this room's components */
+	bool UsesBuildingPool() const;
+
+	/* Spawn a doorway actor for every placed doorway @return Number of actors spawned */
+	int32 SpawnDoorwayActors();
+
+	/* Build collision proxies and register the finished room with its building */
+	void FinishRuntimeGeneration();
+#pragma endregion
+
 protected:
 	// Ensure RoomGenerator is created and initialized (lightweight)
 	virtual bool EnsureGeneratorReady();
+
+	/* True when every style asset and mesh of RoomData is resident. Otherwise streams them (one async request for
+	 * the meshes, preceded by one for the style assets if needed) and calls Continuation once they are loaded.
+	 * Continuations of a completed request pass straight through, whether or not every reference resolved */
+	bool EnsureRoomAssetsLoaded(void (ARoomSpawner::*Continuation)());
 	
 	/* Update visualization based on current grid state */
 	virtual void UpdateVisualization();
@@ -156,6 +233,9 @@ private:
 	
 	// Flag to track if room is generated
 	bool bIsGenerated;
+
+	/* Cleared while portal culling hides this room */
+	bool bMeshesVisible = true;
 	
 #pragma region Mesh Components & Actors
 	// Track spawned floor mesh instances
@@ -184,6 +264,73 @@ private:
 	TSubclassOf<ADoorway> DoorwayActorClass;
 #pragma endregion
 
+#pragma region Building Instance Pool
+	/* Pool the ranges below live in (may differ from OwningBuilding's after it was reassigned) */
+	TWeakObjectPtr<UBuildingInstancePool> RegisteredPool;
+
+	/* Range handles of each mesh category in RegisteredPool (INDEX_NONE = not pooled) */
+	int32 FloorPoolRange = INDEX_NONE;
+	int32 WallPoolRange = INDEX_NONE;
+	int32 CornerPoolRange = INDEX_NONE;
+	int32 CeilingPoolRange = INDEX_NONE;
+
+	/* Send batches to OwningBuilding's pool (replacing PoolRange) or sync them into this room's ComponentMap
+	 * @return Number of instance slots changed (own components) or instances added (pool) */
+	int32 SubmitMeshBatches(const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, int32& PoolRange, const FString& ComponentNamePrefix,
+	bool bInstanceCollision);
+
+	/* Swap-remove PoolRange from RegisteredPool and reset it */
+	void ReleasePoolRange(int32& PoolRange);
+
+	/* Pooled instances are baked in the pool owner's space, so they are re-baked whenever the room moves
+	 * (the building's portal graph is marked dirty as well) */
+	void OnRoomTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+#pragma endregion
+
+#pragma region Mesh Categories
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& GetCategoryComponents(ERoomMeshCategory Category);
+	int32& GetCategoryPoolRange(ERoomMeshCategory Category);
+	static const TCHAR* GetCategoryComponentPrefix(ERoomMeshCategory Category);
+
+	/* Corners always keep instance collision, the rest only without merged collision proxies */
+	bool HasInstanceCollision(ERoomMeshCategory Category) const { return Category == ERoomMeshCategory::Corner || !bUseMergedCollision; }
+
+	/* Destroy every spawned doorway actor */
+	void DestroyDoorwayActors();
+
+	/* Running or last time-sliced generation */
+	UPROPERTY()
+	TObjectPtr<URoomGenerationJob> GenerationJob;
+#pragma endregion
+
+#pragma region Collision Proxies
+	/* Merged floor/wall colliders of the current layout (reused across regenerations) */
+	UPROPERTY()
+	TArray<UBoxComponent*> CollisionBoxComponents;
+
+	/* Fit CollisionBoxComponents to URoomGenerator::BuildCollisionBoxes (none when merged collision is off) */
+	void RebuildCollisionProxies();
+#pragma endregion
+
+#pragma region Asset Streaming
+	/* Style assets loaded, request the meshes they reference */
+	void StreamRoomMeshAssets();
+
+	/* Meshes loaded, run the queued generation functions */
+	void OnRoomAssetsStreamed();
+
+	/* Handles keep the streamed assets resident while this spawner uses them */
+	TSharedPtr<FStreamableHandle> StyleAssetHandle;
+	TSharedPtr<FStreamableHandle> MeshAssetHandle;
+
+	/* Generation functions waiting for the in-flight request */
+	TArray<void (ARoomSpawner::*)()> PendingAssetContinuations;
+
+	/* Set while the continuations of a completed request run, so references that failed to load are not requested again */
+	bool bRunningAssetContinuations = false;
+#pragma endregion
+
 #pragma region Debug Functions
 	/* Log room statistics to output */
 	void LogRoomStatistics();
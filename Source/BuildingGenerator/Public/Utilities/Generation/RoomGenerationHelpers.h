@@ -6,8 +6,34 @@
 #include "Data/Generation/RoomGenerationTypes.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Data/Grid/GridData.h"
+#include "Generators/Rooms/Kernel/RoomGenerationKernel.h"
 #include "RoomGenerationHelpers.generated.h"
 
+class UDoorData;
+class URoomData;
+
+/**
+ * FEdgeCellView - Virtual boundary cells of one wall edge, computed on the fly (no allocation)
+ * Same order as GetEdgeCellIndices: North/South run along +Y, East/West along +X. */
+struct FEdgeCellView
+{
+	FIntPoint Origin = FIntPoint::ZeroValue;
+	FIntPoint Step = FIntPoint::ZeroValue;
+	int32 Length = 0;
+
+	int32 Num() const { return Length; }
+	bool IsValidIndex(int32 CellIndex) const { return CellIndex >= 0 && CellIndex < Length; }
+	FIntPoint operator[](int32 CellIndex) const { return Origin + Step * CellIndex; }
+
+	/* Index of Cell along this edge (INDEX_NONE if the cell is not on it) */
+	int32 IndexOf(FIntPoint Cell) const
+	{
+		const FIntPoint Offset = Cell - Origin;
+		const int32 CellIndex = Step.X != 0 ? Offset.X : Offset.Y;
+		return (IsValidIndex(CellIndex) && Offset == Step * CellIndex) ? CellIndex : INDEX_NONE;
+	}
+};
+
 UCLASS()
 class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLibrary
 {
@@ -20,6 +46,9 @@ class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLi
 	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Grid")
 	static TArray<FIntPoint> GetEdgeCellIndices(EWallEdge Edge, FIntPoint GridSize);
 
+	/* Allocation-free view of the same cells, prefer this in generation code */
+	static FEdgeCellView GetEdgeCellView(EWallEdge Edge, FIntPoint GridSize);
+
 	/** Check if a coordinate is within grid bounds
 	* @param Coord - Coordinate to check @param GridSize - Size of the grid @return True if coordinate is valid */
 	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Grid")
@@ -70,6 +99,12 @@ class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLi
 	* @param RotationDegrees - Rotation in degrees @return True if 90° or 270° rotation */
 	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Rotation")
 	static bool DoesRotationSwapDimensions(int32 RotationDegrees);
+
+	/* Footprint of a pool entry in cells (GridFootprint, or 1x1 when unset) */
+	static FIntPoint CalculateMeshFootprint(const FMeshPlacementInfo& MeshInfo);
+
+	/* Compile a mesh pool into kernel footprint buckets (MeshId = pool index) */
+	static void CompileTilePool(const TArray<FMeshPlacementInfo>& TilePool, FKernelTilePool& OutPool);
 #pragma endregion
 	 
 #pragma region Wall Edge Operations
@@ -91,10 +126,18 @@ class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLi
 	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Doorways")
 	static FVector CalculateDoorwayPosition(EWallEdge Edge, int32 StartCell, 
 	int32 WidthInCells, FIntPoint GridSize, float CellSize);
+
+	/* Doorway opening as a segment along its edge (room space, floor level), used as a visibility portal */
+	static void CalculateDoorwayOpening(EWallEdge Edge, int32 StartCell, int32 WidthInCells, FIntPoint GridSize, float CellSize,
+	FVector& OutStart, FVector& OutEnd);
+
+	/* Compile wall modules into a kernel footprint table (ModuleId = pool index) */
+	static void CompileWallModuleTable(const TArray<FWallModule>& Modules, FKernelWallModuleTable& OutTable);
 #pragma endregion
 	
 #pragma region Mesh Operations
-	/** Load and validate a static mesh with error logging
+	/** Resolve and validate a static mesh with error logging
+	* Never loads: the mesh must already be resident (streamed before generation), otherwise nullptr is returned
 	* @param MeshAsset - Soft pointer to mesh @param ContextName - Name for logging context
 	* @param bLogWarning - Log if mesh fails to load @return Loaded mesh or nullptr if failed */
 	static UStaticMesh* LoadAndValidateMesh(
@@ -106,6 +149,22 @@ class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLi
 	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Transform")
 	static FTransform CalculateMeshTransform(FIntPoint GridPosition, FIntPoint MeshSize, float CellSize,
 	int32 Rotation = 0,	float ZOffset = 0.0f);
+
+	/* Transform of a ceiling tile: centred on its footprint at CeilingHeight, CeilingRotation plus the tile's yaw */
+	static FTransform CalculateCeilingTransform(FIntPoint GridPosition, FIntPoint TileSize, float CellSize, int32 Rotation,
+	const FRotator& CeilingRotation, float CeilingHeight);
+#pragma endregion
+
+#pragma region Asset Preloading
+	/* Soft paths of the style assets a room references (floor, wall, door, ceiling), unloaded ones only */
+	static void GatherRoomStyleAssets(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths);
+
+	/* Soft paths of every mesh reachable from a room (floor, wall layers, corners, columns, door frames, side fills,
+	 * ceilings and designer overrides), unloaded ones only. Style assets must already be resident. */
+	static void GatherRoomMeshAssets(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths);
+
+	/* Soft paths of the meshes of one door style (frame, side fills, side modules), unloaded ones only */
+	static void GatherDoorMeshAssets(const UDoorData* DoorData, TArray<FSoftObjectPath>& OutPaths);
 #pragma endregion
 	 
 #pragma region Transform Operations
@@ -123,21 +182,29 @@ class BUILDINGGENERATOR_API URoomGenerationHelpers : public UBlueprintFunctionLi
 #pragma endregion
 	 
 #pragma region Weighted Selection
-	/* Select random item from array using weighted selection */
-	template<typename T>
-	static const T* SelectWeightedRandom(const TArray<T>& Items, TFunction<float(const T&)> GetWeightFunc);
+	/* Select random item from array using weighted selection (draws from Stream, never the global RNG)
+	 * One-off picks only, repeated picks from the same pool should build an alias table once */
+	template<typename T, typename WeightFuncType>
+	static const T* SelectWeightedRandom(const TArray<T>& Items, WeightFuncType&& GetWeightFunc, FRandomStream& Stream);
+
+	/* Build an O(1) sampling table over Items (sampled index = index into Items) */
+	template<typename T, typename WeightFuncType>
+	static void BuildWeightedAliasTable(const TArray<T>& Items, WeightFuncType&& GetWeightFunc, FKernelAliasTable& OutTable);
+
+	/* Alias table over PlacementWeight of a mesh pool */
+	static void BuildMeshPlacementAliasTable(const TArray<FMeshPlacementInfo>& MeshPool, FKernelAliasTable& OutTable);
 
 	/* Select random wall module using weighted selection */
-	static const FWallModule* SelectWeightedWallModule(const TArray<FWallModule>& Modules);
+	static const FWallModule* SelectWeightedWallModule(const TArray<FWallModule>& Modules, FRandomStream& Stream);
 
 	/* Select random mesh placement info using weighted selection */
-	static const FMeshPlacementInfo* SelectWeightedMeshPlacement(const TArray<FMeshPlacementInfo>& MeshPool);
+	static const FMeshPlacementInfo* SelectWeightedMeshPlacement(const TArray<FMeshPlacementInfo>& MeshPool, FRandomStream& Stream);
 #pragma endregion
 };
 
 // TEMPLATE IMPLEMENTATIONS (Must be in header)
-template<typename T>
-const T* URoomGenerationHelpers::SelectWeightedRandom(const TArray<T>& Items, TFunction<float(const T&)> GetWeightFunc)
+template<typename T, typename WeightFuncType>
+const T* URoomGenerationHelpers::SelectWeightedRandom(const TArray<T>& Items, WeightFuncType&& GetWeightFunc, FRandomStream& Stream)
 {
 	if (Items.Num() == 0) return nullptr;
 
@@ -148,12 +215,12 @@ const T* URoomGenerationHelpers::SelectWeightedRandom(const TArray<T>& Items, TF
 	// If all weights are zero, select uniformly
 	if (TotalWeight <= 0.0f)
 	{
-		int32 RandomIndex = FMath::RandRange(0, Items.Num() - 1);
+		int32 RandomIndex = Stream.RandRange(0, Items.Num() - 1);
 		return &Items[RandomIndex];
 	}
 
 	// Weighted random selection
-	float RandomValue = FMath::FRandRange(0.0f, TotalWeight);
+	float RandomValue = Stream.FRandRange(0.0f, TotalWeight);
 	float CurrentWeight = 0.0f;
 
 	for (const T& Item :  Items)
@@ -165,3 +232,13 @@ const T* URoomGenerationHelpers::SelectWeightedRandom(const TArray<T>& Items, TF
 	// Fallback (should never reach here)
 	return &Items. Last();
 };
+
+template<typename T, typename WeightFuncType>
+void URoomGenerationHelpers::BuildWeightedAliasTable(const TArray<T>& Items, WeightFuncType&& GetWeightFunc, FKernelAliasTable& OutTable)
+{
+	TArray<float> Weights;
+	Weights.Reserve(Items.Num());
+	for (const T& Item : Items) { Weights.Add(GetWeightFunc(Item)); }
+
+	OutTable.Build(Weights);
+}
@@ -32,9 +32,23 @@ class BUILDINGGENERATOR_API URoomSpawnerHelpers : public UBlueprintFunctionLibra
 	static int32 SpawnMeshInstance( UInstancedStaticMeshComponent* ISMComponent, const FTransform& LocalTransform,
 	const FVector& WorldOffset);
 
-	/* Spawn multiple mesh instances from an array */
+	/* Spawn multiple mesh instances with a single AddInstances call (one render state / navigation update) */
 	static int32 SpawnMeshInstances(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
 	const FVector& WorldOffset);
+
+	/* Submit placements grouped by mesh, one GetOrCreateISMComponent + SpawnMeshInstances per mesh
+	 * @return Total number of instances added */
+	static int32 SpawnMeshInstanceBatches(AActor* Owner, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, const FString& ComponentNamePrefix,
+	const FVector& WorldOffset, bool bLogWarnings = true);
+
+	/* Bring existing components to exactly the given batches without recreating them
+	 * Unchanged instances are kept, changed slots are updated in place, only the surplus is removed or added in bulk.
+	 * Components whose mesh is no longer placed are emptied but stay registered for the next regeneration.
+	 * @return Number of instance slots touched (updated + added + removed) */
+	static int32 SyncMeshInstanceBatches(AActor* Owner, const TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches,
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, const FString& ComponentNamePrefix,
+	const FVector& WorldOffset, bool bLogWarnings = true);
 #pragma endregion
 	
 #pragma region Mesh Transform Utilities
@@ -48,10 +62,13 @@ class BUILDINGGENERATOR_API URoomSpawnerHelpers : public UBlueprintFunctionLibra
 	
 #pragma region Wall Spawning
 	/** Spawn a complete wall segment (Base + Middle layers + Top)
-	* @param Owner - Actor owning ISM components @param PlacedWall - contains transform / module data
+	* @param Owner - Actor owning ISM components @param PlacedWall - layer transforms @param Module - module the record indexes
 	* @param WallComponents - Map of ISM components @param RoomOrigin - World position for room
 	* @param ComponentPrefix - Prefix for ISM component names @param DebugHelpers - debug helper for logging */
-	static void SpawnWallSegment(AActor* Owner, const FPlacedWallInfo& PlacedWall, TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& WallComponents,
+	static void SpawnWallSegment(AActor* Owner, const FPlacedWallInfo& PlacedWall, const FWallModule& Module, TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& WallComponents,
 	const FVector& RoomOrigin, const FString& ComponentPrefix = TEXT("WallISM_"), class UDebugHelpers* DebugHelpers = nullptr);
+
+	/* Append the layer transforms of a wall segment (Base + optional Middle1/Middle2/Top) to per-mesh batches */
+	static void AddWallSegmentToBatches(const FPlacedWallInfo& PlacedWall, const FWallModule& Module, TMap<TSoftObjectPtr<UStaticMesh>, TArray<FTransform>>& Batches);
 #pragma endregion
 };
\ No newline at end of file